@@ -0,0 +1,644 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: HelloService.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_HelloService_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_HelloService_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_HelloService_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_HelloService_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_HelloService_2eproto;
+namespace hello {
+class HelloRequest;
+struct HelloRequestDefaultTypeInternal;
+extern HelloRequestDefaultTypeInternal _HelloRequest_default_instance_;
+class HelloResponse;
+struct HelloResponseDefaultTypeInternal;
+extern HelloResponseDefaultTypeInternal _HelloResponse_default_instance_;
+}  // namespace hello
+PROTOBUF_NAMESPACE_OPEN
+template<> ::hello::HelloRequest* Arena::CreateMaybeMessage<::hello::HelloRequest>(Arena*);
+template<> ::hello::HelloResponse* Arena::CreateMaybeMessage<::hello::HelloResponse>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace hello {
+
+// ===================================================================
+
+class HelloRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:hello.HelloRequest) */ {
+ public:
+  inline HelloRequest() : HelloRequest(nullptr) {}
+  ~HelloRequest() override;
+  explicit PROTOBUF_CONSTEXPR HelloRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HelloRequest(const HelloRequest& from);
+  HelloRequest(HelloRequest&& from) noexcept
+    : HelloRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline HelloRequest& operator=(const HelloRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HelloRequest& operator=(HelloRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HelloRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HelloRequest* internal_default_instance() {
+    return reinterpret_cast<const HelloRequest*>(
+               &_HelloRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(HelloRequest& a, HelloRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HelloRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HelloRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HelloRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HelloRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const HelloRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HelloRequest& from) {
+    HelloRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HelloRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "hello.HelloRequest";
+  }
+  protected:
+  explicit HelloRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kAgeFieldNumber = 2,
+    kStreamCountFieldNumber = 3,
+    kStreamIntervalMsFieldNumber = 4,
+  };
+  // string name = 1;
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // int32 age = 2;
+  void clear_age();
+  int32_t age() const;
+  void set_age(int32_t value);
+  private:
+  int32_t _internal_age() const;
+  void _internal_set_age(int32_t value);
+  public:
+
+  // optional int32 stream_count = 3;
+  bool has_stream_count() const;
+  private:
+  bool _internal_has_stream_count() const;
+  public:
+  void clear_stream_count();
+  int32_t stream_count() const;
+  void set_stream_count(int32_t value);
+  private:
+  int32_t _internal_stream_count() const;
+  void _internal_set_stream_count(int32_t value);
+  public:
+
+  // optional int32 stream_interval_ms = 4;
+  bool has_stream_interval_ms() const;
+  private:
+  bool _internal_has_stream_interval_ms() const;
+  public:
+  void clear_stream_interval_ms();
+  int32_t stream_interval_ms() const;
+  void set_stream_interval_ms(int32_t value);
+  private:
+  int32_t _internal_stream_interval_ms() const;
+  void _internal_set_stream_interval_ms(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:hello.HelloRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    int32_t age_;
+    int32_t stream_count_;
+    int32_t stream_interval_ms_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_HelloService_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HelloResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:hello.HelloResponse) */ {
+ public:
+  inline HelloResponse() : HelloResponse(nullptr) {}
+  ~HelloResponse() override;
+  explicit PROTOBUF_CONSTEXPR HelloResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HelloResponse(const HelloResponse& from);
+  HelloResponse(HelloResponse&& from) noexcept
+    : HelloResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline HelloResponse& operator=(const HelloResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HelloResponse& operator=(HelloResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HelloResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HelloResponse* internal_default_instance() {
+    return reinterpret_cast<const HelloResponse*>(
+               &_HelloResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(HelloResponse& a, HelloResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HelloResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HelloResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HelloResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HelloResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const HelloResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HelloResponse& from) {
+    HelloResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HelloResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "hello.HelloResponse";
+  }
+  protected:
+  explicit HelloResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMessageFieldNumber = 1,
+    kTimestampFieldNumber = 2,
+  };
+  // string message = 1;
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // int64 timestamp = 2;
+  void clear_timestamp();
+  int64_t timestamp() const;
+  void set_timestamp(int64_t value);
+  private:
+  int64_t _internal_timestamp() const;
+  void _internal_set_timestamp(int64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:hello.HelloResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    int64_t timestamp_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_HelloService_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// HelloRequest
+
+// string name = 1;
+inline void HelloRequest::clear_name() {
+  _impl_.name_.ClearToEmpty();
+}
+inline const std::string& HelloRequest::name() const {
+  // @@protoc_insertion_point(field_get:hello.HelloRequest.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HelloRequest::set_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hello.HelloRequest.name)
+}
+inline std::string* HelloRequest::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:hello.HelloRequest.name)
+  return _s;
+}
+inline const std::string& HelloRequest::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void HelloRequest::_internal_set_name(const std::string& value) {
+  
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HelloRequest::_internal_mutable_name() {
+  
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HelloRequest::release_name() {
+  // @@protoc_insertion_point(field_release:hello.HelloRequest.name)
+  return _impl_.name_.Release();
+}
+inline void HelloRequest::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hello.HelloRequest.name)
+}
+
+// int32 age = 2;
+inline void HelloRequest::clear_age() {
+  _impl_.age_ = 0;
+}
+inline int32_t HelloRequest::_internal_age() const {
+  return _impl_.age_;
+}
+inline int32_t HelloRequest::age() const {
+  // @@protoc_insertion_point(field_get:hello.HelloRequest.age)
+  return _internal_age();
+}
+inline void HelloRequest::_internal_set_age(int32_t value) {
+  
+  _impl_.age_ = value;
+}
+inline void HelloRequest::set_age(int32_t value) {
+  _internal_set_age(value);
+  // @@protoc_insertion_point(field_set:hello.HelloRequest.age)
+}
+
+// optional int32 stream_count = 3;
+inline bool HelloRequest::_internal_has_stream_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool HelloRequest::has_stream_count() const {
+  return _internal_has_stream_count();
+}
+inline void HelloRequest::clear_stream_count() {
+  _impl_.stream_count_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline int32_t HelloRequest::_internal_stream_count() const {
+  return _impl_.stream_count_;
+}
+inline int32_t HelloRequest::stream_count() const {
+  // @@protoc_insertion_point(field_get:hello.HelloRequest.stream_count)
+  return _internal_stream_count();
+}
+inline void HelloRequest::_internal_set_stream_count(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.stream_count_ = value;
+}
+inline void HelloRequest::set_stream_count(int32_t value) {
+  _internal_set_stream_count(value);
+  // @@protoc_insertion_point(field_set:hello.HelloRequest.stream_count)
+}
+
+// optional int32 stream_interval_ms = 4;
+inline bool HelloRequest::_internal_has_stream_interval_ms() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool HelloRequest::has_stream_interval_ms() const {
+  return _internal_has_stream_interval_ms();
+}
+inline void HelloRequest::clear_stream_interval_ms() {
+  _impl_.stream_interval_ms_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t HelloRequest::_internal_stream_interval_ms() const {
+  return _impl_.stream_interval_ms_;
+}
+inline int32_t HelloRequest::stream_interval_ms() const {
+  // @@protoc_insertion_point(field_get:hello.HelloRequest.stream_interval_ms)
+  return _internal_stream_interval_ms();
+}
+inline void HelloRequest::_internal_set_stream_interval_ms(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.stream_interval_ms_ = value;
+}
+inline void HelloRequest::set_stream_interval_ms(int32_t value) {
+  _internal_set_stream_interval_ms(value);
+  // @@protoc_insertion_point(field_set:hello.HelloRequest.stream_interval_ms)
+}
+
+// -------------------------------------------------------------------
+
+// HelloResponse
+
+// string message = 1;
+inline void HelloResponse::clear_message() {
+  _impl_.message_.ClearToEmpty();
+}
+inline const std::string& HelloResponse::message() const {
+  // @@protoc_insertion_point(field_get:hello.HelloResponse.message)
+  return _internal_message();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HelloResponse::set_message(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.message_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:hello.HelloResponse.message)
+}
+inline std::string* HelloResponse::mutable_message() {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:hello.HelloResponse.message)
+  return _s;
+}
+inline const std::string& HelloResponse::_internal_message() const {
+  return _impl_.message_.Get();
+}
+inline void HelloResponse::_internal_set_message(const std::string& value) {
+  
+  _impl_.message_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HelloResponse::_internal_mutable_message() {
+  
+  return _impl_.message_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HelloResponse::release_message() {
+  // @@protoc_insertion_point(field_release:hello.HelloResponse.message)
+  return _impl_.message_.Release();
+}
+inline void HelloResponse::set_allocated_message(std::string* message) {
+  if (message != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.message_.SetAllocated(message, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.message_.IsDefault()) {
+    _impl_.message_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:hello.HelloResponse.message)
+}
+
+// int64 timestamp = 2;
+inline void HelloResponse::clear_timestamp() {
+  _impl_.timestamp_ = int64_t{0};
+}
+inline int64_t HelloResponse::_internal_timestamp() const {
+  return _impl_.timestamp_;
+}
+inline int64_t HelloResponse::timestamp() const {
+  // @@protoc_insertion_point(field_get:hello.HelloResponse.timestamp)
+  return _internal_timestamp();
+}
+inline void HelloResponse::_internal_set_timestamp(int64_t value) {
+  
+  _impl_.timestamp_ = value;
+}
+inline void HelloResponse::set_timestamp(int64_t value) {
+  _internal_set_timestamp(value);
+  // @@protoc_insertion_point(field_set:hello.HelloResponse.timestamp)
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace hello
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_HelloService_2eproto
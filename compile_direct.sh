@@ -110,6 +110,8 @@ GRPC_PLUS_PLUS_FLAGS=$(pkg-config --cflags --libs grpc++)
 
 # Common compiler flags
 CXX_FLAGS="-std=c++17 -Wall -Wextra -O2 -pthread"
+# The epoll server's handlers are C++20 coroutines
+EPOLL_CXX_FLAGS="${CXX_FLAGS/-std=c++17/-std=c++20}"
 INCLUDE_FLAGS="-I. -I../src"
 
 print_status "Compiling optimized server executable..."
@@ -118,8 +120,13 @@ print_status "Compiling optimized server executable..."
 g++ $CXX_FLAGS $INCLUDE_FLAGS \
     ../src/main.cpp \
     ../src/HelloService.cpp \
+    ../src/ArenaMessageAllocator.cpp \
+    ../src/GreetingFormatter.cpp \
+    ../src/CoarseClock.cpp \
     ../src/ServerManager.cpp \
+    ../src/AsyncServer.cpp \
     ../src/LoggingInterceptor.cpp \
+    ../src/AsyncLogger.cpp \
     HelloService.pb.cc \
     HelloService.grpc.pb.cc \
     $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS \
@@ -146,24 +153,54 @@ fi
 
 # Compile epoll server
 if [ "$NUMA_AVAILABLE" = true ]; then
-    g++ $CXX_FLAGS $INCLUDE_FLAGS -DHAVE_NUMA \
+    g++ $EPOLL_CXX_FLAGS $INCLUDE_FLAGS -DHAVE_NUMA \
         ../src/main_epoll.cpp \
         ../src/EpollServer.cpp \
+        ../src/PerfCounters.cpp \
+        ../src/ResponseCache.cpp \
+        ../src/ResponseTemplate.cpp \
+        ../src/StatsSegment.cpp \
+        ../src/EventTrace.cpp \
         ../src/HelloService.cpp \
+        ../src/ArenaMessageAllocator.cpp \
+        ../src/GreetingFormatter.cpp \
+        ../src/CoarseClock.cpp \
+        ../src/ShmRing.cpp \
+        ../src/HotRestart.cpp \
+        ../src/WorkStealingExecutor.cpp \
+        ../src/EpollHandlers.cpp \
+        ../src/FrameScanner.cpp \
+        ../src/UdpFanout.cpp \
         ../src/LoggingInterceptor.cpp \
+        ../src/AsyncLogger.cpp \
         HelloService.pb.cc \
         HelloService.grpc.pb.cc \
-        $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS $NUMA_FLAGS \
+        $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS $NUMA_FLAGS -lrt \
         -o gRpcSvr_epoll
 else
-    g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    g++ $EPOLL_CXX_FLAGS $INCLUDE_FLAGS \
         ../src/main_epoll.cpp \
         ../src/EpollServer.cpp \
+        ../src/PerfCounters.cpp \
+        ../src/ResponseCache.cpp \
+        ../src/ResponseTemplate.cpp \
+        ../src/StatsSegment.cpp \
+        ../src/EventTrace.cpp \
         ../src/HelloService.cpp \
+        ../src/ArenaMessageAllocator.cpp \
+        ../src/GreetingFormatter.cpp \
+        ../src/CoarseClock.cpp \
+        ../src/ShmRing.cpp \
+        ../src/HotRestart.cpp \
+        ../src/WorkStealingExecutor.cpp \
+        ../src/EpollHandlers.cpp \
+        ../src/FrameScanner.cpp \
+        ../src/UdpFanout.cpp \
         ../src/LoggingInterceptor.cpp \
+        ../src/AsyncLogger.cpp \
         HelloService.pb.cc \
         HelloService.grpc.pb.cc \
-        $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS \
+        $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS -lrt \
         -o gRpcSvr_epoll
 fi
 
@@ -277,6 +314,112 @@ else
     exit 1
 fi
 
+print_status "Compiling shared-memory stats viewer..."
+
+# Compile live stats viewer (attaches read-only to the epoll server's /dev/shm segment)
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/stats_top.cpp \
+    ../src/StatsSegment.cpp \
+    -lrt \
+    -o gRpcSvr_top
+
+if [ $? -eq 0 ]; then
+    print_success "Stats viewer compiled successfully"
+else
+    print_error "Stats viewer compilation failed"
+    exit 1
+fi
+
+print_status "Compiling event trace decoder..."
+
+# Compile decoder for the epoll server's binary event traces
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/trace_decode.cpp \
+    ../src/EventTrace.cpp \
+    -o gRpcSvr_trace_decode
+
+if [ $? -eq 0 ]; then
+    print_success "Trace decoder compiled successfully"
+else
+    print_error "Trace decoder compilation failed"
+    exit 1
+fi
+
+print_status "Compiling allocation benchmark..."
+
+# Compile allocation benchmark (in-process server, heap vs arena messages)
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/alloc_benchmark.cpp \
+    ../src/HelloService.cpp \
+    ../src/ArenaMessageAllocator.cpp \
+    ../src/GreetingFormatter.cpp \
+    ../src/CoarseClock.cpp \
+    ../src/ServerManager.cpp \
+    ../src/AsyncServer.cpp \
+    ../src/LoggingInterceptor.cpp \
+    ../src/AsyncLogger.cpp \
+    HelloService.pb.cc \
+    HelloService.grpc.pb.cc \
+    $PROTOBUF_FLAGS $GRPC_PLUS_PLUS_FLAGS \
+    -o gRpcSvr_alloc_bench
+
+if [ $? -eq 0 ]; then
+    print_success "Allocation benchmark compiled successfully"
+else
+    print_error "Allocation benchmark compilation failed"
+    exit 1
+fi
+
+print_status "Compiling frame scanner benchmark..."
+
+# Compile frame scanner microbenchmark (scalar vs SSE4.2 vs AVX2 on 16 KB reads)
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/frame_scan_benchmark.cpp \
+    ../src/FrameScanner.cpp \
+    -o gRpcSvr_frame_bench
+
+if [ $? -eq 0 ]; then
+    print_success "Frame scanner benchmark compiled successfully"
+else
+    print_error "Frame scanner benchmark compilation failed"
+    exit 1
+fi
+
+print_status "Compiling UDP fan-out subscriber..."
+
+# Compile UDP fan-out subscriber (recvmmsg, gap detection; needs gRpcSvr_epoll --udp-publish)
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/udp_subscriber.cpp \
+    ../src/UdpFanout.cpp \
+    ../src/ResponseTemplate.cpp \
+    ../src/GreetingFormatter.cpp \
+    -o gRpcSvr_udp_subscriber
+
+if [ $? -eq 0 ]; then
+    print_success "UDP fan-out subscriber compiled successfully"
+else
+    print_error "UDP fan-out subscriber compilation failed"
+    exit 1
+fi
+
+print_status "Compiling shared-memory transport latency test..."
+
+# Compile shared-memory ring client and its latency test (needs gRpcSvr_epoll --shm)
+g++ $CXX_FLAGS $INCLUDE_FLAGS \
+    ../src/shm_latency_test.cpp \
+    ../src/ShmClient.cpp \
+    ../src/ShmRing.cpp \
+    HelloService.pb.cc \
+    $PROTOBUF_FLAGS \
+    -o gRpcSvr_shm_latency_test
+
+if [ $? -eq 0 ]; then
+    print_success "Shared-memory latency test compiled successfully"
+else
+    print_error "Shared-memory latency test compilation failed"
+    exit 1
+fi
+
 # List generated executables
 echo ""
 print_status "Generated executables:"
@@ -320,22 +463,85 @@ if [ -f "gRpcSvr_hft_perf_test" ]; then
     ls -lh gRpcSvr_hft_perf_test
 fi
 
+if [ -f "gRpcSvr_top" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_top (Shared-Memory Stats Viewer)"
+    ls -lh gRpcSvr_top
+fi
+
+if [ -f "gRpcSvr_trace_decode" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_trace_decode (Event Trace Decoder)"
+    ls -lh gRpcSvr_trace_decode
+fi
+
+if [ -f "gRpcSvr_alloc_bench" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_alloc_bench (Allocation Benchmark)"
+    ls -lh gRpcSvr_alloc_bench
+fi
+
+if [ -f "gRpcSvr_frame_bench" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_frame_bench (Frame Scanner Benchmark)"
+    ls -lh gRpcSvr_frame_bench
+fi
+
+if [ -f "gRpcSvr_udp_subscriber" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_udp_subscriber (UDP Fan-out Subscriber)"
+    ls -lh gRpcSvr_udp_subscriber
+fi
+
+if [ -f "gRpcSvr_shm_latency_test" ]; then
+    echo -e "  ${GREEN}✓${NC} gRpcSvr_shm_latency_test (Shared-Memory Transport Latency Test)"
+    ls -lh gRpcSvr_shm_latency_test
+fi
+
 echo ""
 print_success "Direct compilation completed successfully!"
 echo "All executables are in the build_direct directory."
 echo ""
 print_status "To run the optimized server:"
 echo "  cd build_direct && ./gRpcSvr_optimized"
+echo "  cd build_direct && ./gRpcSvr_optimized --mode async"
+echo "  cd build_direct && ./gRpcSvr_optimized --mode callback"
 echo ""
 print_status "To run the epoll-optimized server:"
 echo "  cd build_direct && ./gRpcSvr_epoll"
 echo ""
+print_status "To serve co-located clients over Unix domain sockets as well as TCP:"
+echo "  cd build_direct && ./gRpcSvr_optimized --uds /tmp/gRpcSvr.sock"
+echo "  cd build_direct && ./gRpcSvr_latency_test unix:/tmp/gRpcSvr.sock"
+echo "  cd build_direct && ./gRpcSvr_epoll --uds /tmp/gRpcSvr_epoll.sock"
+echo "  cd build_direct && ./gRpcSvr_hft_perf_test unix:/tmp/gRpcSvr_epoll.sock"
+echo ""
+print_status "To measure the shared-memory ring transport:"
+echo "  cd build_direct && ./gRpcSvr_epoll --shm /tmp/gRpcSvr_shm.sock"
+echo "  cd build_direct && ./gRpcSvr_shm_latency_test /tmp/gRpcSvr_shm.sock busy"
+echo "  cd build_direct && ./gRpcSvr_epoll --handoff /tmp/gRpcSvr_epoll.handoff   # then, to hot-restart:"
+echo "  cd build_direct && ./gRpcSvr_epoll --handoff /tmp/gRpcSvr_epoll.handoff --takeover-connections"
+echo ""
+print_status "To fan updates out over UDP (sendmmsg, optional GSO) to local subscribers:"
+echo "  cd build_direct && ./gRpcSvr_epoll --udp-publish 127.0.0.1:50060 --udp-publish 239.1.1.1:50061 --udp-gso"
+echo "  cd build_direct && ./gRpcSvr_udp_subscriber 50060"
+echo "  cd build_direct && ./gRpcSvr_udp_subscriber 50061 239.1.1.1"
+echo ""
 print_status "To run epoll performance tests:"
 echo "  cd build_direct && ./gRpcSvr_epoll_perf_test"
 echo ""
 print_status "To run HFT performance tests:"
 echo "  cd build_direct && ./gRpcSvr_hft_perf_test 127.0.0.1 50052"
 echo ""
+print_status "To watch live epoll server statistics:"
+echo "  cd build_direct && ./gRpcSvr_top 50052"
+echo "  cd build_direct && ./gRpcSvr_epoll --critical-port 50053   # per-lane latency in gRpcSvr_top"
+echo ""
+print_status "To record and decode a per-worker event trace:"
+echo "  cd build_direct && ./gRpcSvr_epoll --trace epoll.trace"
+echo "  cd build_direct && ./gRpcSvr_trace_decode epoll.trace --summary"
+echo ""
+print_status "To compare heap and arena message allocations:"
+echo "  cd build_direct && ./gRpcSvr_alloc_bench 5000"
+echo ""
+print_status "To benchmark HTTP/2 frame scanning per instruction set:"
+echo "  cd build_direct && ./gRpcSvr_frame_bench 100000"
+echo ""
 print_status "To run other tests:"
 echo "  cd build_direct && ./gRpcSvr_client"
 echo "  cd build_direct && ./gRpcSvr_perf_test"
@@ -361,4 +567,22 @@ echo "✓ HFT-optimized server with lock-free operations"
 echo "✓ CPU affinity and NUMA awareness"
 echo "✓ Pre-compiled responses and memory pools"
 echo "✓ Ultra-low latency optimizations"
+echo "✓ Shared-memory statistics with live top-style viewer"
+echo "✓ Per-worker binary event tracing with timeline decoder"
+echo "✓ Protobuf arena allocation for unary RPCs"
+echo "✓ Async completion-queue server mode with per-core queues"
+echo "✓ Callback (reactor) server mode"
+echo "✓ Timer-paced, non-blocking server streaming"
+echo "✓ Cached coarse clock for response timestamps"
+echo "✓ Unix domain socket listeners alongside TCP"
+echo "✓ Shared-memory (memfd) ring transport for co-located clients"
+echo "✓ Hot restart with listening-socket handoff"
+echo "✓ Queue-delay (CoDel) load shedding with RESOURCE_EXHAUSTED responses"
+echo "✓ grpc-timeout deadlines and RST_STREAM cancellation on the epoll path"
+echo "✓ Priority lanes: dedicated workers and cores for latency-critical clients"
+echo "✓ Work-stealing executor for offloaded (expensive) handlers"
+echo "✓ C++20 coroutine handlers with pooled frames (epoll server)"
+echo "✓ Perfect-hash method routing on :path (epoll server)"
+echo "✓ SIMD (SSE4.2/AVX2) frame scanning of pipelined receive batches"
+echo "✓ UDP fan-out with sendmmsg/recvmmsg, GSO and sequence gap detection"
 echo "==========================================" 
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hello {
+
+// CoDel-style admission control for one worker. Each request reports how long
+// it waited before the worker got to it (its queue delay). The controller
+// tracks the smallest delay seen in every interval: a standing queue shows up
+// as a minimum that stays above target, while a burst that drains does not.
+//
+// Once an interval ends with its minimum above target the worker counts as
+// overloaded, and requests that have already waited more than twice the
+// target are shed instead of served. They would most likely miss their
+// caller's deadline anyway, and answering them late only delays everyone
+// queued behind. Shedding stops after the first interval whose minimum falls
+// back under target. (This is the server-side variant of CoDel used by
+// folly/wangle: a fixed slough threshold instead of CoDel's drop schedule.)
+//
+// Not thread-safe: each worker owns one controller.
+class AdmissionController {
+public:
+    struct Options {
+        bool enabled = true;
+        uint64_t target_us = 5000;     // acceptable standing queue delay
+        uint64_t interval_us = 100000; // window the minimum is taken over
+    };
+
+    AdmissionController() = default;
+    explicit AdmissionController(const Options& options) : options_(options) {}
+
+    void configure(const Options& options) {
+        options_ = options;
+        interval_end_us_ = 0;
+        min_delay_us_ = UINT64_MAX;
+        overloaded_ = false;
+    }
+
+    // True to serve the request, false to shed it
+    bool admit(uint64_t queue_delay_us, uint64_t now_us) {
+        if (!options_.enabled) {
+            return true;
+        }
+
+        if (now_us >= interval_end_us_) {
+            // An interval with no requests carries no evidence of a queue
+            overloaded_ = min_delay_us_ != UINT64_MAX && min_delay_us_ > options_.target_us;
+            interval_end_us_ = now_us + options_.interval_us;
+            min_delay_us_ = queue_delay_us;
+            return true;
+        }
+        if (queue_delay_us < min_delay_us_) {
+            min_delay_us_ = queue_delay_us;
+        }
+        return !(overloaded_ && queue_delay_us > 2 * options_.target_us);
+    }
+
+    bool overloaded() const { return overloaded_; }
+    const Options& options() const { return options_; }
+
+private:
+    Options options_;
+    uint64_t interval_end_us_ = 0;
+    uint64_t min_delay_us_ = UINT64_MAX;
+    bool overloaded_ = false;
+};
+
+} // namespace hello
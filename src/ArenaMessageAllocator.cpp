@@ -0,0 +1,70 @@
+#include "ArenaMessageAllocator.h"
+#include <vector>
+
+namespace hello {
+
+namespace {
+
+class ArenaHolder;
+
+// Holders freed on this thread, reused by the next allocation on it. gRPC may
+// release a holder on a different thread than the one that allocated it; that
+// is fine, holders are not tied to a thread.
+struct HolderCache {
+    std::vector<ArenaHolder*> holders;
+    ~HolderCache();
+};
+
+thread_local HolderCache t_holder_cache;
+
+class ArenaHolder : public grpc::MessageHolder<HelloRequest, HelloResponse> {
+public:
+    ArenaHolder() : arena_(initial_block_, sizeof(initial_block_)) {
+        set_request(google::protobuf::Arena::CreateMessage<HelloRequest>(&arena_));
+        set_response(google::protobuf::Arena::CreateMessage<HelloResponse>(&arena_));
+    }
+
+    void Release() override {
+        // Clearing instead of resetting the arena keeps both messages and the
+        // capacity of their strings, so the next RPC on this holder fills them
+        // without allocating
+        request()->Clear();
+        response()->Clear();
+
+        auto& cache = t_holder_cache.holders;
+        if (cache.size() < ArenaMessageAllocator::MAX_CACHED_PER_THREAD) {
+            cache.push_back(this);
+        } else {
+            delete this;
+        }
+    }
+
+private:
+    alignas(16) char initial_block_[ArenaMessageAllocator::INITIAL_BLOCK_SIZE];
+    google::protobuf::Arena arena_;
+};
+
+HolderCache::~HolderCache() {
+    for (ArenaHolder* holder : holders) {
+        delete holder;
+    }
+}
+
+} // namespace
+
+grpc::MessageHolder<HelloRequest, HelloResponse>* ArenaMessageAllocator::AllocateMessages() {
+    auto& cache = t_holder_cache.holders;
+    if (!cache.empty()) {
+        ArenaHolder* holder = cache.back();
+        cache.pop_back();
+        return holder;
+    }
+
+    holders_created_.fetch_add(1, std::memory_order_relaxed);
+    if (cache.capacity() == 0) {
+        cache.reserve(MAX_CACHED_PER_THREAD);
+    }
+    return new ArenaHolder();
+}
+
+} // namespace hello
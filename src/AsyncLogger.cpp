@@ -0,0 +1,240 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+namespace hello {
+
+namespace {
+
+// Returns the calling thread's ring to the logger when the thread exits
+struct ThreadRingHandle {
+    LogRing* ring = nullptr;
+
+    ~ThreadRingHandle() {
+        if (ring) {
+            ring->owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRingHandle t_ring;
+
+void appendNumber(std::string& out, uint64_t value) {
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr - digits);
+}
+
+} // namespace
+
+bool LogRing::tryPush(const LogRecord& record) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ >= CAPACITY) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head - cached_tail_ >= CAPACITY) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    records_[head & (CAPACITY - 1)] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t LogRing::drain(LogRecord* out, size_t max_records) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t count = 0;
+
+    while (tail != head && count < max_records) {
+        out[count++] = records_[tail & (CAPACITY - 1)];
+        ++tail;
+    }
+
+    tail_.store(tail, std::memory_order_release);
+    return count;
+}
+
+AsyncLogger& AsyncLogger::getInstance() {
+    static AsyncLogger instance;
+    return instance;
+}
+
+AsyncLogger::AsyncLogger() {
+    batch_.reserve(DRAIN_BATCH * 4);
+    line_buffer_.reserve(DRAIN_BATCH * 4 * 96);
+
+    running_.store(true);
+    writer_thread_ = std::thread(&AsyncLogger::writerThread, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    running_.store(false);
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    flush();
+
+    for (auto& slot : rings_) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogger::logRequest(const char* method) {
+    push(LogKind::Request, method, 0, 0);
+}
+
+void AsyncLogger::logResponse(const char* method, int status_code, uint64_t duration_us) {
+    push(LogKind::Response, method, status_code, duration_us);
+}
+
+void AsyncLogger::push(LogKind kind, const char* method, int status_code, uint64_t duration_us) {
+    LogRing* ring = threadRing();
+    if (!ring) {
+        unregistered_drops_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LogRecord record;
+    record.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.duration_us = duration_us;
+    record.status_code = status_code;
+    record.kind = static_cast<uint8_t>(kind);
+
+    size_t len = method ? strnlen(method, LogRecord::MAX_METHOD) : 0;
+    record.method_len = static_cast<uint8_t>(len);
+    if (len > 0) {
+        memcpy(record.method, method, len);
+    }
+
+    ring->tryPush(record);
+}
+
+LogRing* AsyncLogger::threadRing() {
+    if (t_ring.ring) {
+        return t_ring.ring;
+    }
+
+    // First record from this thread: adopt a ring released by an exited thread,
+    // or create a new one. Rings live until the logger is destroyed.
+    std::lock_guard<std::mutex> lock(register_mutex_);
+    int count = ring_count_.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        LogRing* ring = rings_[i].load(std::memory_order_relaxed);
+        bool expected = false;
+        if (ring->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            t_ring.ring = ring;
+            return ring;
+        }
+    }
+
+    if (count >= MAX_RINGS) {
+        return nullptr;
+    }
+
+    auto* ring = new LogRing();
+    ring->owned.store(true, std::memory_order_relaxed);
+    rings_[count].store(ring, std::memory_order_release);
+    ring_count_.store(count + 1, std::memory_order_release);
+    t_ring.ring = ring;
+    return ring;
+}
+
+uint64_t AsyncLogger::recordsDropped() const {
+    uint64_t dropped = unregistered_drops_.load(std::memory_order_relaxed);
+    int count = ring_count_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        dropped += rings_[i].load(std::memory_order_acquire)->dropped();
+    }
+    return dropped;
+}
+
+void AsyncLogger::flush() {
+    while (drainOnce() > 0) {
+    }
+}
+
+void AsyncLogger::writerThread() {
+    while (running_.load(std::memory_order_relaxed)) {
+        if (drainOnce() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_US));
+        }
+    }
+}
+
+size_t AsyncLogger::drainOnce() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+
+    batch_.clear();
+    int count = ring_count_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        LogRing* ring = rings_[i].load(std::memory_order_acquire);
+        if (ring->empty()) continue;
+        size_t offset = batch_.size();
+        batch_.resize(offset + DRAIN_BATCH);
+        batch_.resize(offset + ring->drain(batch_.data() + offset, DRAIN_BATCH));
+    }
+
+    if (batch_.empty()) {
+        return 0;
+    }
+
+    // Each ring is ordered; merge them so the output reads chronologically
+    std::stable_sort(batch_.begin(), batch_.end(),
+                     [](const LogRecord& a, const LogRecord& b) { return a.wall_ns < b.wall_ns; });
+
+    line_buffer_.clear();
+    for (const auto& record : batch_) {
+        formatRecord(record, line_buffer_);
+    }
+
+    int fd = output_fd_.load(std::memory_order_relaxed);
+    const char* data = line_buffer_.data();
+    size_t remaining = line_buffer_.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+
+    records_written_.fetch_add(batch_.size(), std::memory_order_relaxed);
+    return batch_.size();
+}
+
+void AsyncLogger::formatRecord(const LogRecord& record, std::string& out) {
+    int64_t second = static_cast<int64_t>(record.wall_ns / 1000000000ULL);
+    if (second != cached_second_) {
+        time_t time = static_cast<time_t>(second);
+        struct tm tm;
+        localtime_r(&time, &tm);
+        cached_timestamp_len_ = strftime(cached_timestamp_, sizeof(cached_timestamp_), "[%Y-%m-%d %H:%M:%S] ", &tm);
+        cached_second_ = second;
+    }
+
+    out.append(cached_timestamp_, cached_timestamp_len_);
+    if (record.kind == static_cast<uint8_t>(LogKind::Request)) {
+        out.append("REQUEST: ");
+        out.append(record.method, record.method_len);
+    } else {
+        out.append("RESPONSE: ");
+        out.append(record.method, record.method_len);
+        out.append(record.status_code == 0 ? " - Status: OK" : " - Status: ERROR");
+        out.append(" - Duration: ");
+        appendNumber(out, record.duration_us / 1000);
+        out.append("ms");
+    }
+    out.push_back('\n');
+}
+
+} // namespace hello
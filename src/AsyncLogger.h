@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+
+namespace hello {
+
+enum class LogKind : uint8_t {
+    Request = 1,
+    Response,
+};
+
+// Fixed-size binary record; formatting to text happens on the logger thread
+struct LogRecord {
+    static constexpr size_t MAX_METHOD = 106;
+
+    uint64_t wall_ns;       // system_clock time of the event
+    uint64_t duration_us;   // Response only
+    int32_t status_code;    // Response only, grpc::StatusCode
+    uint8_t kind;
+    uint8_t method_len;
+    char method[MAX_METHOD];
+};
+static_assert(sizeof(LogRecord) == 128, "LogRecord must stay two cache lines");
+
+// Single-producer/single-consumer ring owned by one logging thread. A ring is
+// handed back to the logger when its thread exits and reused by the next one.
+class LogRing {
+public:
+    static constexpr size_t CAPACITY = 1024; // 128 KB per logging thread
+
+    bool tryPush(const LogRecord& record);
+
+    // Consumer side: copies up to max_records into out, returns the count
+    size_t drain(LogRecord* out, size_t max_records);
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    std::atomic<bool> owned{false};
+
+private:
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0;
+    std::atomic<uint64_t> dropped_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::array<LogRecord, CAPACITY> records_;
+};
+
+// Process-wide asynchronous logger. Callers copy a binary record into their
+// thread's ring and return without locks, syscalls or formatting; one background
+// thread merges the rings, formats the lines (the timestamp text is cached per
+// second) and writes them to the output fd in batches. Records are dropped and
+// counted rather than blocking when a ring is full.
+class AsyncLogger {
+public:
+    static AsyncLogger& getInstance();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void logRequest(const char* method);
+    void logResponse(const char* method, int status_code, uint64_t duration_us);
+
+    // Writes everything queued so far before returning
+    void flush();
+
+    // Redirects output (default: stdout); the logger does not take ownership
+    void setOutputFd(int fd) { output_fd_.store(fd, std::memory_order_relaxed); }
+
+    uint64_t recordsWritten() const { return records_written_.load(std::memory_order_relaxed); }
+    uint64_t recordsDropped() const;
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    void push(LogKind kind, const char* method, int status_code, uint64_t duration_us);
+    LogRing* threadRing();
+    void writerThread();
+    size_t drainOnce();
+    void formatRecord(const LogRecord& record, std::string& out);
+
+    static constexpr int MAX_RINGS = 256;
+    static constexpr int IDLE_SLEEP_US = 1000;
+    static constexpr size_t DRAIN_BATCH = 512;
+
+    std::array<std::atomic<LogRing*>, MAX_RINGS> rings_{};
+    std::atomic<int> ring_count_{0};
+    std::mutex register_mutex_;
+
+    // Consumer state, owned by whoever holds drain_mutex_
+    std::mutex drain_mutex_;
+    std::vector<LogRecord> batch_;
+    std::string line_buffer_;
+    int64_t cached_second_ = -1;
+    char cached_timestamp_[32];
+    size_t cached_timestamp_len_ = 0;
+
+    std::atomic<int> output_fd_{1};
+    std::atomic<bool> running_{false};
+    std::thread writer_thread_;
+    std::atomic<uint64_t> records_written_{0};
+    std::atomic<uint64_t> unregistered_drops_{0};
+};
+
+} // namespace hello
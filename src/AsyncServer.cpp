@@ -0,0 +1,232 @@
+#include "AsyncServer.h"
+#include "HelloService.h"
+#include <grpcpp/alarm.h>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+
+namespace hello {
+
+namespace {
+
+// Completion queue tag; every tag on the queues is a CallData
+class CallData {
+public:
+    virtual ~CallData() = default;
+    virtual void proceed(bool ok) = 0;
+};
+
+class SayHelloCall final : public CallData {
+public:
+    SayHelloCall(HelloService::AsyncService* service, grpc::ServerCompletionQueue* cq)
+        : service_(service), cq_(cq), responder_(&context_) {
+        service_->RequestSayHello(&context_, &request_, &responder_, cq_, cq_, this);
+    }
+
+    void proceed(bool ok) override {
+        if (state_ == State::Request) {
+            // Not ok: the server is shutting down and no call arrived
+            if (!ok) {
+                delete this;
+                return;
+            }
+
+            // Keep a slot posted for the next call on this queue
+            new SayHelloCall(service_, cq_);
+
+            HelloServiceImpl::buildHelloResponse(request_, &response_);
+            state_ = State::Finish;
+            responder_.Finish(response_, grpc::Status::OK, this);
+        } else {
+            delete this;
+        }
+    }
+
+private:
+    enum class State { Request, Finish };
+
+    HelloService::AsyncService* service_;
+    grpc::ServerCompletionQueue* cq_;
+    grpc::ServerContext context_;
+    HelloRequest request_;
+    HelloResponse response_;
+    grpc::ServerAsyncResponseWriter<HelloResponse> responder_;
+    State state_ = State::Request;
+};
+
+// Same schedule as the callback stream reactor (see HelloService.cpp): message
+// k at start + k * interval, using an alarm on the call's own queue instead of
+// a sleep. Due messages are chained without waiting, and the last one is sent
+// together with the status through WriteAndFinish.
+class SayHelloStreamCall final : public CallData {
+public:
+    SayHelloStreamCall(HelloService::AsyncService* service, grpc::ServerCompletionQueue* cq,
+                       const StreamPacing* pacing)
+        : service_(service), cq_(cq), pacing_(pacing), writer_(&context_) {
+        service_->RequestSayHelloStream(&context_, &request_, &writer_, cq_, cq_, this);
+    }
+
+    void proceed(bool ok) override {
+        switch (state_) {
+            case State::Request:
+                if (!ok) {
+                    delete this;
+                    return;
+                }
+                new SayHelloStreamCall(service_, cq_, pacing_);
+
+                count_ = pacing_->countFor(request_);
+                interval_ = pacing_->intervalFor(request_);
+                start_ = std::chrono::system_clock::now();
+
+                if (count_ == 0) {
+                    state_ = State::Finish;
+                    writer_.Finish(grpc::Status::OK, this);
+                } else {
+                    writeDue();
+                }
+                break;
+
+            case State::Write:
+                if (!ok) {
+                    // Client went away; the stream can only be finished now
+                    state_ = State::Finish;
+                    writer_.Finish(grpc::Status(grpc::StatusCode::INTERNAL, "Failed to write stream"), this);
+                } else if (sent_ < due_) {
+                    writeNext();
+                } else {
+                    state_ = State::Pause;
+                    alarm_.Set(cq_, start_ + interval_ * sent_, this);
+                }
+                break;
+
+            case State::Pause:
+                writeDue();
+                break;
+
+            case State::Finish:
+                delete this;
+                break;
+        }
+    }
+
+private:
+    enum class State { Request, Write, Pause, Finish };
+
+    void writeDue() {
+        if (interval_.count() == 0) {
+            due_ = count_;
+        } else {
+            int64_t reached = (std::chrono::system_clock::now() - start_) / interval_ + 1;
+            due_ = static_cast<int32_t>(std::min<int64_t>(reached, count_));
+        }
+        writeNext();
+    }
+
+    void writeNext() {
+        ++sent_;
+        HelloServiceImpl::buildStreamResponse(request_, sent_, &response_);
+
+        if (sent_ == count_) {
+            state_ = State::Finish;
+            writer_.WriteAndFinish(response_, grpc::WriteOptions(), grpc::Status::OK, this);
+            return;
+        }
+        state_ = State::Write;
+        writer_.Write(response_, this);
+    }
+
+    HelloService::AsyncService* service_;
+    grpc::ServerCompletionQueue* cq_;
+    const StreamPacing* pacing_;
+    grpc::ServerContext context_;
+    HelloRequest request_;
+    HelloResponse response_;
+    grpc::ServerAsyncWriter<HelloResponse> writer_;
+    grpc::Alarm alarm_;
+    int32_t count_ = 0;
+    std::chrono::milliseconds interval_{0};
+    std::chrono::system_clock::time_point start_;
+    int32_t sent_ = 0;
+    int32_t due_ = 0;
+    State state_ = State::Request;
+};
+
+bool pinToCore(unsigned core) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+} // namespace
+
+AsyncHelloServer::AsyncHelloServer(unsigned num_queues, const StreamPacing& pacing)
+    : num_queues_(num_queues > 0 ? num_queues : 1), pacing_(pacing) {
+}
+
+AsyncHelloServer::~AsyncHelloServer() {
+    stop();
+}
+
+void AsyncHelloServer::configure(grpc::ServerBuilder& builder) {
+    builder.RegisterService(&service_);
+    for (unsigned i = 0; i < num_queues_; ++i) {
+        queues_.push_back(builder.AddCompletionQueue());
+    }
+}
+
+void AsyncHelloServer::start() {
+    for (auto& cq : queues_) {
+        for (int i = 0; i < CALLS_PER_QUEUE; ++i) {
+            new SayHelloCall(&service_, cq.get());
+            new SayHelloStreamCall(&service_, cq.get(), &pacing_);
+        }
+    }
+
+    for (unsigned i = 0; i < queues_.size(); ++i) {
+        threads_.emplace_back(&AsyncHelloServer::drainQueue, this, i, true);
+    }
+}
+
+void AsyncHelloServer::stop() {
+    if (stopped_) {
+        return;
+    }
+    stopped_ = true;
+
+    for (auto& cq : queues_) {
+        cq->Shutdown();
+    }
+
+    if (threads_.empty()) {
+        // Never started: drain on this thread so the queues can be destroyed
+        for (unsigned i = 0; i < queues_.size(); ++i) {
+            drainQueue(i, false);
+        }
+    }
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+void AsyncHelloServer::drainQueue(unsigned index, bool pin) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (pin && cores > 0 && !pinToCore(index % cores)) {
+        std::cerr << "Failed to pin completion queue thread " << index << std::endl;
+    }
+
+    grpc::ServerCompletionQueue* cq = queues_[index].get();
+    void* tag;
+    bool ok;
+    while (cq->Next(&tag, &ok)) {
+        static_cast<CallData*>(tag)->proceed(ok);
+    }
+}
+
+} // namespace hello
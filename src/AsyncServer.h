@@ -0,0 +1,50 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "HelloService.h"
+
+namespace hello {
+
+// Completion-queue driven HelloService. There is one ServerCompletionQueue per
+// core, each drained by a thread pinned to that core. An RPC stays on the queue
+// that accepted it, so it runs start to finish on one thread instead of being
+// handed from a poller thread to a handler thread. Streams are paced by
+// grpc::Alarm (see StreamPacing), so a stream never blocks its queue thread.
+class AsyncHelloServer {
+public:
+    // Accepted-call slots kept posted per queue and per method
+    static constexpr int CALLS_PER_QUEUE = 8;
+
+    AsyncHelloServer(unsigned num_queues, const StreamPacing& pacing);
+    ~AsyncHelloServer();
+
+    AsyncHelloServer(const AsyncHelloServer&) = delete;
+    AsyncHelloServer& operator=(const AsyncHelloServer&) = delete;
+
+    // Registers the service and creates the queues; call before BuildAndStart()
+    void configure(grpc::ServerBuilder& builder);
+
+    // Posts the initial calls and starts the queue threads; call after BuildAndStart()
+    void start();
+
+    // Shuts the queues down and joins their threads; call after grpc::Server::Shutdown()
+    void stop();
+
+    unsigned numQueues() const { return num_queues_; }
+
+private:
+    void drainQueue(unsigned index, bool pin);
+
+    HelloService::AsyncService service_;
+    unsigned num_queues_;
+    StreamPacing pacing_;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> queues_;
+    std::vector<std::thread> threads_;
+    bool stopped_ = false;
+};
+
+} // namespace hello
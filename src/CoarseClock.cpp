@@ -0,0 +1,85 @@
+#include "CoarseClock.h"
+#include <time.h>
+
+namespace hello {
+
+CoarseClock& CoarseClock::getInstance() {
+    static CoarseClock instance;
+    return instance;
+}
+
+CoarseClock::~CoarseClock() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    publishing_.store(false, std::memory_order_relaxed);
+    if (ticker_.joinable()) {
+        ticker_.join();
+    }
+}
+
+void CoarseClock::start(std::chrono::microseconds tick) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (users_++ > 0) {
+        return;
+    }
+
+    publishing_.store(true, std::memory_order_relaxed);
+    publish();
+    ticker_ = std::thread(&CoarseClock::tickerThread, this, tick);
+}
+
+void CoarseClock::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (users_ == 0 || --users_ > 0) {
+        return;
+    }
+
+    publishing_.store(false, std::memory_order_relaxed);
+    if (ticker_.joinable()) {
+        ticker_.join();
+    }
+    // Readers fall back to the precise clock from here on
+    now_us_.value.store(0, std::memory_order_relaxed);
+}
+
+void CoarseClock::publish() {
+    if (!publishing_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Several publishers may race; keep the newest value
+    uint64_t now = preciseMicros();
+    uint64_t published = now_us_.value.load(std::memory_order_relaxed);
+    while (now > published &&
+           !now_us_.value.compare_exchange_weak(published, now, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t CoarseClock::preciseMicros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void CoarseClock::tickerThread(std::chrono::microseconds tick) {
+    // Absolute deadlines so the tick does not drift with the publish cost
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (publishing_.load(std::memory_order_relaxed)) {
+        next.tv_nsec += tick.count() * 1000;
+        while (next.tv_nsec >= 1000000000) {
+            next.tv_nsec -= 1000000000;
+            ++next.tv_sec;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+        publish();
+
+        // After a long preemption, restart from now instead of catching up
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > next.tv_sec + 1) {
+            next = now;
+        }
+    }
+}
+
+} // namespace hello
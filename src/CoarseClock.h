@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace hello {
+
+// Which clock a call site stamps responses with
+enum class ClockSource {
+    Precise, // clock_gettime on every call
+    Cached   // CoarseClock's published value: one load, at most one tick old
+};
+
+// Published value on its own cache line, away from anything written often
+struct alignas(64) PublishedTime {
+    std::atomic<uint64_t> value{0};
+};
+
+// Shared wall clock for response timestamps. A ticker thread (and any event
+// loop that calls publish() when it wakes) stores the current time in
+// microseconds since the epoch into a cache-line-aligned atomic; readers take
+// a single relaxed load instead of a clock_gettime per message. While nothing
+// publishes, nowMicros() falls back to the precise clock, so a stopped clock
+// never hands out stale time.
+class CoarseClock {
+public:
+    static constexpr std::chrono::microseconds DEFAULT_TICK{100};
+
+    static CoarseClock& getInstance();
+
+    CoarseClock(const CoarseClock&) = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+    // The first start() launches the ticker; start/stop pairs from several
+    // servers in one process are counted, the last stop() ends it
+    void start(std::chrono::microseconds tick = DEFAULT_TICK);
+    void stop();
+    bool isRunning() const { return now_us_.value.load(std::memory_order_relaxed) != 0; }
+
+    // Publishes the current time if the clock is running; never moves it back
+    static void publish();
+
+    static uint64_t nowMicros() {
+        uint64_t now = now_us_.value.load(std::memory_order_relaxed);
+        return now != 0 ? now : preciseMicros();
+    }
+
+    static uint64_t preciseMicros();
+
+private:
+    CoarseClock() = default;
+    ~CoarseClock();
+
+    void tickerThread(std::chrono::microseconds tick);
+
+    static inline PublishedTime now_us_;
+    static inline std::atomic<bool> publishing_{false};
+
+    std::mutex mutex_;
+    int users_ = 0;
+    std::thread ticker_;
+};
+
+inline uint64_t timestampMicros(ClockSource source) {
+    return source == ClockSource::Cached ? CoarseClock::nowMicros() : CoarseClock::preciseMicros();
+}
+
+} // namespace hello
@@ -0,0 +1,34 @@
+#include "EpollHandlers.h"
+#include "GreetingFormatter.h"
+#include "HelloService.h"
+#include <optional>
+
+namespace hello {
+
+namespace {
+
+// HandlerContext reports an unset field as -1
+std::optional<int32_t> requested(int32_t value) {
+    return value < 0 ? std::nullopt : std::optional<int32_t>(value);
+}
+
+} // namespace
+
+Handler sayHelloStream(HandlerContext& context) {
+    StreamPacing pacing;
+    int32_t count = pacing.countFor(requested(context.streamCount()));
+    std::chrono::milliseconds interval = pacing.intervalFor(requested(context.streamIntervalMs()));
+
+    // Messages are numbered from 1, as in the other SayHelloStream handlers
+    for (int32_t index = 1; index <= count; ++index) {
+        if (index > 1) {
+            co_await context.sleep(interval);
+        }
+        if (!co_await context.write(GreetingFormatter::streamGreeting(context.name(), context.age(), index))) {
+            co_return; // stream reset or connection closed
+        }
+    }
+    co_await context.finish();
+}
+
+} // namespace hello
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "EpollServer.h"
+
+namespace hello {
+
+// Coroutine handlers for EpollServer::registerHandler
+
+// SayHelloStream: the same paced greetings as the callback reactor
+// (HelloServiceImpl::startStream), written as a plain loop. StreamPacing
+// supplies the defaults and limits; the request may override count and
+// interval. The worker is free between messages.
+Handler sayHelloStream(HandlerContext& context);
+
+} // namespace hello
@@ -2,6 +2,7 @@
 
 #include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
@@ -17,13 +18,25 @@
 #include <condition_variable>
 #include <string>
 #include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstring>
 #include <bitset>
 #include <sched.h>
 #include <netinet/tcp.h>
 #include <sys/mman.h>
+#include "StatsSegment.h"
+#include "PerfCounters.h"
+#include "ResponseCache.h"
+#include "ShmRing.h"
+#include "AdmissionControl.h"
+#include "HotRestart.h"
+#include "WorkStealingExecutor.h"
+#include "MethodRouter.h"
+#include <string_view>
 #ifdef HAVE_NUMA
 #include <numa.h>
-#include <linux/mempolicy.h>
+#include <numaif.h>
 #endif
 
 namespace hello {
@@ -36,9 +49,10 @@ class LoggingInterceptor;
 template<typename T, size_t PoolSize = 1024>
 class LockFreeMemoryPool {
 private:
+    // data comes first so deallocate() can map a T* straight back to its Node
     struct Node {
-        std::atomic<Node*> next;
         T data;
+        std::atomic<Node*> next;
     };
     
     alignas(64) std::atomic<Node*> head_;
@@ -83,7 +97,32 @@ public:
     }
     
     size_t allocated() const { return allocated_.load(std::memory_order_relaxed); }
+    
+    // True for pointers handed out by this pool
+    bool owns(const void* ptr) const {
+        return ptr >= static_cast<const void*>(pool_.data()) && ptr < static_cast<const void*>(pool_.data() + PoolSize);
+    }
+};
+
+// Which stream a queued response frame answers and when its caller stops
+// waiting for it (0 = no deadline)
+struct WriteTag {
+    uint32_t stream_id = 0;
+    uint64_t deadline_us = 0;
+};
+
+// Priority lane of a connection. Critical connections are served by their
+// own workers from their own epoll set, so a bulk client flooding the server
+// cannot queue ahead of them
+enum class TrafficClass : uint8_t {
+    Critical = 0,
+    Bulk = 1
 };
+constexpr int NUM_TRAFFIC_CLASSES = 2;
+
+inline const char* trafficClassName(TrafficClass traffic_class) {
+    return traffic_class == TrafficClass::Critical ? "critical" : "bulk";
+}
 
 // HFT-optimized connection with pre-allocated buffers and lock-free operations
 struct Connection {
@@ -97,11 +136,33 @@ struct Connection {
     size_t read_pos;
     size_t write_pos;
     
-    // Lock-free write queue using ring buffer
+    // Write queue: a ring of fixed-size slots holding one frame each.
+    // Producers encode straight into the head slot (reserveWrite/commitWrite)
+    // and the sender sends from the tail slot in place (peekWrite/consumeWrite),
+    // so a response is never copied through an intermediate buffer.
+    //
+    // Neither side is confined to one thread: any worker may read the
+    // connection, drain an offload completion for it, resume one of its
+    // coroutine handlers or take its EPOLLOUT. So the head is advanced only
+    // under producer_mutex (enqueueWrite() takes it; callers of
+    // reserveWrite()/commitWrite() hold it from reserve to commit), and the
+    // tail only by the worker holding sender_mutex (handleClientWrite).
     static constexpr size_t RING_BUFFER_SIZE = 64;
-    alignas(64) std::array<std::array<uint8_t, 4096>, RING_BUFFER_SIZE> write_queue;
+    static constexpr size_t WRITE_SLOT_SIZE = 4096;
+    alignas(64) std::array<std::array<uint8_t, WRITE_SLOT_SIZE>, RING_BUFFER_SIZE> write_queue;
+    std::array<uint32_t, RING_BUFFER_SIZE> write_lengths{};
+    
+    // Per-slot WriteTag; an unsent frame past its deadline, or whose stream
+    // was reset, is discarded instead of sent
+    static constexpr uint64_t CANCELLED = 1; // deadline of a frame whose stream was reset
+    std::array<uint32_t, RING_BUFFER_SIZE> write_streams{};
+    std::array<std::atomic<uint64_t>, RING_BUFFER_SIZE> write_deadlines{};
+    size_t write_offset = 0; // bytes of the tail slot already sent
     alignas(64) std::atomic<size_t> write_head{0};
+    std::mutex producer_mutex;
     alignas(64) std::atomic<size_t> write_tail{0};
+    std::mutex sender_mutex;
+    std::atomic<bool> send_requested{false}; // a worker found the sender busy
     
     bool keep_alive;
     time_t last_activity;
@@ -109,6 +170,12 @@ struct Connection {
     // CPU core affinity for this connection
     int cpu_core;
     
+    // From the listener it arrived on, or an x-priority request header
+    TrafficClass traffic_class = TrafficClass::Bulk;
+    
+    // Requests on the executor whose response is not queued yet
+    std::atomic<uint32_t> offloads_in_flight{0};
+    
     Connection() : fd(-1), read_pos(0), write_pos(0), keep_alive(false), 
                    last_activity(0), cpu_core(-1) {
         // Zero-initialize buffers
@@ -136,33 +203,246 @@ struct Connection {
         }
     }
     
-    // Lock-free write queue operations
-    bool enqueueWrite(const std::vector<uint8_t>& data) {
+    // Write queue operations
+    
+    // Head slot to encode a frame of up to size bytes into, or nullptr when the
+    // queue is full or the frame does not fit a slot. Caller holds producer_mutex
+    uint8_t* reserveWrite(size_t size) {
+        if (size > WRITE_SLOT_SIZE) {
+            return nullptr;
+        }
+        size_t head = write_head.load(std::memory_order_relaxed);
+        if ((head + 1) % RING_BUFFER_SIZE == write_tail.load(std::memory_order_acquire)) {
+            return nullptr; // Queue full
+        }
+        return write_queue[head].data();
+    }
+    
+    // Publishes the frame written into the slot returned by reserveWrite()
+    void commitWrite(size_t size, WriteTag tag = {}) {
+        size_t head = write_head.load(std::memory_order_relaxed);
+        write_lengths[head] = static_cast<uint32_t>(size);
+        write_streams[head] = tag.stream_id;
+        write_deadlines[head].store(tag.deadline_us, std::memory_order_relaxed);
+        write_head.store((head + 1) % RING_BUFFER_SIZE, std::memory_order_release);
+    }
+    
+    bool enqueueWrite(const uint8_t* data, size_t size, WriteTag tag = {}) {
+        std::lock_guard<std::mutex> lock(producer_mutex);
+        uint8_t* slot = reserveWrite(size);
+        if (!slot) {
+            return false;
+        }
+        memcpy(slot, data, size);
+        commitWrite(size, tag);
+        return true;
+    }
+    
+    bool enqueueWrite(const std::vector<uint8_t>& data, WriteTag tag = {}) {
+        return enqueueWrite(data.data(), data.size(), tag);
+    }
+    
+    // Marks the queued frames answering stream_id as cancelled (RST_STREAM);
+    // returns how many were still waiting
+    size_t cancelStream(uint32_t stream_id) {
+        size_t cancelled = 0;
         size_t head = write_head.load(std::memory_order_acquire);
-        size_t next_head = (head + 1) % RING_BUFFER_SIZE;
-        
-        if (next_head == write_tail.load(std::memory_order_acquire)) {
-            return false; // Queue full
+        for (size_t i = write_tail.load(std::memory_order_acquire); i != head; i = (i + 1) % RING_BUFFER_SIZE) {
+            if (write_streams[i] == stream_id) {
+                write_deadlines[i].store(CANCELLED, std::memory_order_relaxed);
+                ++cancelled;
+            }
         }
-        
-        size_t data_size = std::min(data.size(), write_queue[head].size());
-        std::copy(data.begin(), data.begin() + data_size, write_queue[head].begin());
-        
-        write_head.store(next_head, std::memory_order_release);
+        return cancelled;
+    }
+    
+    // Discards the oldest queued frame if none of it has been sent yet and
+    // its deadline has passed (or its stream was reset)
+    bool discardStaleWrite(uint64_t now_us) {
+        size_t tail = write_tail.load(std::memory_order_relaxed);
+        if (write_offset != 0 || tail == write_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        uint64_t deadline = write_deadlines[tail].load(std::memory_order_relaxed);
+        if (deadline == 0 || deadline > now_us) {
+            return false;
+        }
+        write_tail.store((tail + 1) % RING_BUFFER_SIZE, std::memory_order_release);
         return true;
     }
     
-    bool dequeueWrite(std::vector<uint8_t>& data) {
-        size_t tail = write_tail.load(std::memory_order_acquire);
-        
+    // Unsent bytes of the oldest queued frame; false when the queue is empty
+    bool peekWrite(const uint8_t*& data, size_t& size) const {
+        size_t tail = write_tail.load(std::memory_order_relaxed);
         if (tail == write_head.load(std::memory_order_acquire)) {
             return false; // Queue empty
         }
-        
-        data.assign(write_queue[tail].begin(), write_queue[tail].end());
-        write_tail.store((tail + 1) % RING_BUFFER_SIZE, std::memory_order_release);
+        data = write_queue[tail].data() + write_offset;
+        size = write_lengths[tail] - write_offset;
         return true;
     }
+    
+    // Marks bytes of the frame returned by peekWrite() as sent, releasing its
+    // slot once the whole frame is out
+    void consumeWrite(size_t bytes) {
+        size_t tail = write_tail.load(std::memory_order_relaxed);
+        write_offset += bytes;
+        if (write_offset >= write_lengths[tail]) {
+            write_offset = 0;
+            write_tail.store((tail + 1) % RING_BUFFER_SIZE, std::memory_order_release);
+        }
+    }
+    
+    bool hasPendingWrites() const {
+        return write_tail.load(std::memory_order_relaxed) != write_head.load(std::memory_order_acquire);
+    }
+    
+    void resetWrites() {
+        write_head.store(0, std::memory_order_relaxed);
+        write_tail.store(0, std::memory_order_relaxed);
+        write_offset = 0;
+        send_requested.store(false, std::memory_order_relaxed);
+        offloads_in_flight.store(0, std::memory_order_relaxed);
+    }
+};
+
+class HandlerContext;
+
+// Work an I/O worker hands to the executor (EpollServer::submitOffload). run
+// executes on an executor thread and ends with EpollServer::returnToWorker(),
+// after which complete runs on the I/O worker that drains the submitter's
+// completion queue
+struct OffloadedWork : ExecutorTask {
+    void (*complete)(ExecutorTask* task) = nullptr;
+    int worker_id = 0;
+};
+
+// Return type of coroutine handlers (EpollServer::registerHandler). A handler
+// starts running as soon as it is called, stays on the I/O worker until its
+// first co_await, and frees its frame when it returns. Frames come from a
+// fixed pool, so neither starting nor suspending a handler allocates.
+struct Handler {
+    struct promise_type {
+        explicit promise_type(HandlerContext& context) : context(&context) {}
+        ~promise_type(); // hands the context back to the server
+        
+        static void* operator new(size_t size) noexcept;
+        static void operator delete(void* frame, size_t size) noexcept;
+        static Handler get_return_object_on_allocation_failure() noexcept { return Handler{false}; }
+        
+        Handler get_return_object() noexcept { return Handler{true}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept;
+        
+        HandlerContext* context;
+    };
+    
+    bool started;
+};
+
+// One call of a coroutine handler: its latest request and the awaitables it
+// suspends on. Each awaitable parks the coroutine on the event loop instead of
+// blocking the worker; whichever worker sees the wake-up (a DATA frame, a
+// timer, an executor completion) resumes it. The server owns the context
+// (pooled) until the coroutine finishes.
+class HandlerContext {
+public:
+    static constexpr size_t MAX_NAME = 64;
+    static constexpr size_t MAX_MESSAGE = 512;
+    
+    // The HelloRequest that started the call, or the last one read()
+    std::string_view name() const { return std::string_view(request_.name.data(), request_.name_size); }
+    int32_t age() const { return request_.age; }
+    int32_t streamCount() const { return request_.stream_count; }            // -1 when unset
+    int32_t streamIntervalMs() const { return request_.stream_interval_ms; } // -1 when unset
+    
+    // co_await read(): the next DATA frame on this stream; false once the
+    // stream is reset or the connection closes
+    struct ReadAwaiter {
+        HandlerContext* context;
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept { return context->read_result_; }
+    };
+    ReadAwaiter read() { return ReadAwaiter{this}; }
+    
+    // co_await write(message): queues a HelloResponse{message} on the stream.
+    // A full write queue parks the handler and retries every WRITE_RETRY_US;
+    // false once the stream is gone or when the message exceeds MAX_MESSAGE
+    struct WriteAwaiter {
+        HandlerContext* context;
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept { return context->write_result_; }
+    };
+    WriteAwaiter write(std::string_view message);
+    
+    // co_await finish(): grpc-status OK trailers, ending the stream
+    WriteAwaiter finish();
+    
+    // co_await sleep(duration): resumes after duration on a timerfd shared by
+    // all handlers
+    struct SleepAwaiter {
+        HandlerContext* context;
+        std::chrono::microseconds duration;
+        bool await_ready() const noexcept { return duration.count() <= 0; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+    SleepAwaiter sleep(std::chrono::microseconds duration) { return SleepAwaiter{this, duration}; }
+    
+    // co_await offload(fn): runs fn on the work-stealing executor and resumes
+    // on an I/O worker afterwards; inline when no executor is running
+    template<typename F>
+    struct OffloadAwaiter : OffloadedWork {
+        OffloadAwaiter(F fn) : fn(std::move(fn)) {}
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+        
+        F fn;
+        std::coroutine_handle<> handle;
+    };
+    template<typename F>
+    OffloadAwaiter<F> offload(F fn) { return OffloadAwaiter<F>(std::move(fn)); }
+    
+private:
+    friend class EpollServer;
+    friend struct Handler::promise_type;
+    
+    enum class TimerAction : uint8_t {
+        Resume,
+        RetryWrite
+    };
+    
+    struct RequestFields {
+        std::array<char, MAX_NAME> name{};
+        size_t name_size = 0;
+        int32_t age = 0;
+        int32_t stream_count = -1;
+        int32_t stream_interval_ms = -1;
+    };
+    
+    std::shared_ptr<Connection> conn_;
+    WriteTag tag_;
+    std::coroutine_handle<> waiting_;     // suspended on a read or a timer
+    TimerAction timer_action_ = TimerAction::Resume;
+    std::atomic<bool> closed_{false};     // stream reset or connection closed
+    
+    // read(): one message may arrive ahead of the read that wants it
+    RequestFields request_;
+    RequestFields unread_;
+    bool has_unread_ = false;
+    bool reading_ = false;
+    bool read_result_ = false;
+    
+    // write()/finish(): the message waits here while the queue is full
+    std::array<char, MAX_MESSAGE> pending_message_;
+    size_t pending_size_ = 0;
+    const std::vector<uint8_t>* pending_frame_ = nullptr; // precompiled frame instead of a message
+    bool write_result_ = false;
 };
 
 // HFT-optimized server with lock-free operations and CPU affinity
@@ -178,6 +458,87 @@ public:
     void stopServer();
     bool isRunning() const;
     
+    // Also accept co-located clients on an AF_UNIX stream socket at path,
+    // next to the TCP listener; must be set before startServer(), empty = TCP only
+    void setUnixSocketPath(const std::string& path) { unix_socket_path_ = path; }
+    const std::string& unixSocketPath() const { return unix_socket_path_; }
+    
+    // Shared-memory transport: clients handshake on an AF_UNIX control socket
+    // at path, receive a memfd ring pair and are each served by a dedicated
+    // pinned session thread (see ShmHelloClient); must be set before startServer()
+    void setShmSocketPath(const std::string& path) { shm_socket_path_ = path; }
+    
+    // Hot restart (see HotRestart.h). setHandoffPath() makes the server accept
+    // successors on path. With takeover set, startServer() first asks the
+    // server already on path for its listening sockets (and, with
+    // connections, its idle client connections), warms up, and only then
+    // tells it to stop accepting; without a server on path it starts cold.
+    // Both must be set before startServer().
+    void setHandoffPath(const std::string& path) { handoff_path_ = path; }
+    void setTakeover(bool takeover, bool connections) {
+        takeover_ = takeover;
+        takeover_connections_ = connections;
+    }
+    
+    // True once a successor has taken over the listeners
+    bool handedOff() const { return handed_off_.load(); }
+    
+    // Priority lanes: connections on critical_port (or sending
+    // "x-priority: critical") are served by critical_workers dedicated
+    // workers, pinned to cores of their own when there are enough, and bulk
+    // workers drain ready critical events ahead of every batch of their own.
+    // critical_workers = 0 keeps a single lane; must be set before startServer()
+    struct PriorityLaneOptions {
+        uint16_t critical_port = 0; // 0 = no separate listener, header only
+        int critical_workers = 0;
+    };
+    void setPriorityLanes(const PriorityLaneOptions& options) { lanes_ = options; }
+    
+    // Handlers for the listed methods (":path" values) run on a
+    // WorkStealingExecutor of threads executor threads instead of the I/O
+    // worker, and their responses come back to the submitting worker through
+    // its completion queue and eventfd. Every other method stays inline.
+    // Only the built-in SayHello encoder is offloaded this way; coroutine
+    // handlers offload() themselves. threads = 0 keeps everything inline;
+    // must be set before startServer()
+    struct OffloadOptions {
+        int threads = 0;
+        std::vector<std::string> methods;
+    };
+    void setOffload(const OffloadOptions& options) { offload_ = options; }
+    WorkStealingExecutor::Stats getExecutorStats() const { return executor_.stats(); }
+    int getExecutorThreads() const { return executor_.threadCount(); }
+    
+    // Executor access for OffloadedWork, from I/O worker threads only.
+    // submitOffload() is false when the work must run inline instead
+    static bool submitOffload(OffloadedWork* work);
+    static void returnToWorker(OffloadedWork* work);
+    
+    // Method routing: requests are dispatched on their ":path" through a
+    // perfect-hash MethodRouter that startServer() builds from the methods
+    // registered here. SayHello and SayHelloStream are built in unless
+    // registered explicitly, requests without ":path" take SayHello, and
+    // unknown methods are answered UNIMPLEMENTED. Routes run after admission
+    // control. Must be registered before startServer(); false if method
+    // already has a route.
+    //
+    // A unary handler encodes its response to the request frames in data
+    // straight into conn's write queue (reserveWrite/commitWrite) and
+    // returns the bytes queued, 0 when it could not (the caller then gets an
+    // error response). It runs on an I/O worker and must not block.
+    using UnaryHandler = size_t (*)(Connection* conn, const uint8_t* data, size_t size, WriteTag tag);
+    bool registerMethod(const std::string& method, UnaryHandler handler);
+    
+    // Coroutine handlers (see HandlerContext) take over the stream for as
+    // long as they run
+    using CoroutineHandler = Handler (*)(HandlerContext& context);
+    bool registerHandler(const std::string& method, CoroutineHandler handler);
+    size_t coroutineFramesInUse() const { return handler_frames_.allocated(); }
+    
+    // After a handoff: waits until the remaining connections and shared-memory
+    // sessions have closed; false if some were still open at the timeout
+    bool drain(std::chrono::milliseconds timeout);
+    
     // Performance monitoring with high-resolution timestamps
     struct ServerStats {
         alignas(64) std::atomic<uint64_t> total_connections{0};
@@ -190,6 +551,36 @@ public:
         alignas(64) std::atomic<uint64_t> cache_misses{0};
         alignas(64) std::atomic<uint64_t> numa_crossings{0};
         
+        // Worker hardware counters (user space only), summed across workers
+        alignas(64) std::atomic<uint64_t> cpu_cycles{0};
+        alignas(64) std::atomic<uint64_t> instructions{0};
+        alignas(64) std::atomic<uint64_t> branch_misses{0};
+        alignas(64) std::atomic<uint64_t> context_switches{0};
+        
+        // Encoded-response cache outcomes, summed across worker shards
+        alignas(64) std::atomic<uint64_t> response_cache_hits{0};
+        alignas(64) std::atomic<uint64_t> response_cache_misses{0};
+        
+        // Requests rejected with RESOURCE_EXHAUSTED by admission control
+        alignas(64) std::atomic<uint64_t> requests_shed{0};
+        
+        // Work nobody would read: requests past their grpc-timeout before the
+        // handler ran, responses dropped unsent after their deadline or an
+        // RST_STREAM, and RST_STREAM frames received
+        alignas(64) std::atomic<uint64_t> requests_expired{0};
+        alignas(64) std::atomic<uint64_t> late_responses_dropped{0};
+        alignas(64) std::atomic<uint64_t> streams_reset{0};
+        
+        // Requests whose handler ran on the work-stealing executor
+        alignas(64) std::atomic<uint64_t> offloaded_requests{0};
+        
+        // Requests for a ":path" with no route, answered UNIMPLEMENTED
+        alignas(64) std::atomic<uint64_t> requests_unimplemented{0};
+        
+        // Coroutine handler calls started, and frames too large for the pool
+        alignas(64) std::atomic<uint64_t> coroutine_handlers{0};
+        alignas(64) std::atomic<uint64_t> coroutine_heap_frames{0};
+        
         // Latency tracking with nanosecond precision
         alignas(64) std::atomic<uint64_t> min_latency_ns{UINT64_MAX};
         alignas(64) std::atomic<uint64_t> max_latency_ns{0};
@@ -199,6 +590,38 @@ public:
     
     ServerStats& getStats() { return stats_; }
     
+    // Per-worker counters; each worker is the only writer of its own entry
+    struct alignas(64) WorkerStats {
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> bytes_received{0};
+        std::atomic<uint64_t> bytes_sent{0};
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> instructions{0};
+        std::atomic<uint64_t> cache_misses{0};
+        std::atomic<uint64_t> branch_misses{0};
+        std::atomic<uint64_t> context_switches{0};
+        std::atomic<uint64_t> requests_shed{0};
+        std::atomic<bool> overloaded{false};
+        alignas(64) std::array<std::atomic<uint64_t>, StatsSegmentLayout::LATENCY_BUCKETS> latency_buckets{};
+        
+        // Per traffic class: requests answered and arrival-to-queued latency
+        std::array<std::atomic<uint64_t>, NUM_TRAFFIC_CLASSES> class_requests{};
+        alignas(64) std::array<std::array<std::atomic<uint64_t>, StatsSegmentLayout::LATENCY_BUCKETS>,
+                               NUM_TRAFFIC_CLASSES> class_latency_buckets{};
+    };
+    
+    const WorkerStats& getWorkerStats(int worker_id) const { return worker_stats_[worker_id]; }
+    int getWorkerCount() const { return NUM_WORKER_THREADS; }
+    
+    // Per-worker perf_event counters; must be set before startServer()
+    void setPerfCountersEnabled(bool enabled) { perf_counters_enabled_ = enabled; }
+    
+    // Queue-delay admission control (see AdmissionControl.h); must be set before startServer()
+    void setAdmissionControl(const AdmissionController::Options& options) { admission_options_ = options; }
+    bool perfCountersActive() const { return perf_counters_active_.load(std::memory_order_relaxed) > 0; }
+    
 private:
     EpollServer() = default;
     ~EpollServer() = default;
@@ -211,30 +634,146 @@ private:
     
     // Epoll event handling with batch processing
     bool initializeEpoll();
+    int openTcpListener(const std::string& address, uint16_t port);
+    int openUnixListener(const std::string& path, int type = SOCK_STREAM);
+    int reuseOrOpenUnixListener(int inherited_fd, const std::string& path);
+    bool registerListeners();
+    void closeListeners(bool unlink_paths);
     bool setNonBlocking(int fd);
-    bool addToEpoll(int fd, uint32_t events);
+    bool addToEpoll(int fd, uint32_t events, TrafficClass lane = TrafficClass::Bulk);
     bool removeFromEpoll(int fd);
     void handleEpollEvents();
+    void dispatchEvent(const struct epoll_event& event, WorkerStats& worker_stats);
+    
+    // Epoll set serving a lane; everything shares epoll_fd_ while lanes are off
+    int laneEpoll(TrafficClass lane) const {
+        return lane == TrafficClass::Critical && critical_epoll_fd_ >= 0 ? critical_epoll_fd_ : epoll_fd_;
+    }
+    void moveToLane(Connection* conn, TrafficClass lane);
     
     // Connection management with lock-free operations
-    void acceptNewConnection();
+    void acceptNewConnection(int listen_fd);
+    void adoptConnection(int client_fd, const struct sockaddr_storage& peer, TrafficClass lane);
     void handleClientData(Connection* conn);
     void handleClientWrite(Connection* conn);
+    bool sendQueued(Connection* conn); // false once the connection is closed
     void closeConnection(Connection* conn);
     void cleanupInactiveConnections();
     
+    // Shared-memory sessions, one thread per attached client
+    struct ShmSession {
+        int control_fd = -1;
+        int cpu_core = 0;
+        ShmChannel channel;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+    void acceptShmClient();
+    void shmSessionThread(ShmSession* session);
+    void reapShmSessions(bool all);
+    
+    // Hot restart, running side: hand listeners to a successor, then drain
+    void acceptHandoff();
+    void serveHandoff(int conn_fd);
+    void transferConnections(int conn_fd);
+    bool settleOffloads(const std::vector<std::shared_ptr<Connection>>& connections);
+    bool flushPendingWrites(Connection* conn);
+    
+    // Hot restart, successor side
+    int requestTakeover(int inherited[HandoffMessage::LISTENER_KINDS]);
+    void completeTakeover(int conn_fd);
+    
     // HTTP/2 and gRPC handling with pre-compiled responses
-    void processGrpcRequest(Connection* conn, const std::vector<uint8_t>& data);
+    void processReceived(Connection* conn, uint64_t arrival_us);
+    void processGrpcRequest(Connection* conn, const uint8_t* data, size_t size, uint64_t arrival_us);
+    void respondWithStatus(Connection* conn, const std::vector<uint8_t>& response, WriteTag tag = {});
+    static bool enqueueOnStream(Connection* conn, const std::vector<uint8_t>& frame, WriteTag tag);
     std::vector<uint8_t> createGrpcResponse(const std::string& message);
-    std::string parseGrpcRequest(const std::vector<uint8_t>& data);
+    std::vector<uint8_t> createStatusResponse(int grpc_status, const std::string& message);
+    size_t writeHelloResponse(Connection* conn, const uint8_t* data, size_t size, WriteTag tag);
+    void recordAnswered(const Connection* conn, uint64_t arrival_us);
+    
+    // Method routing; offload is only honoured for the built-in SayHello
+    // encoder, which is what an OffloadTask runs
+    struct MethodRoute {
+        UnaryHandler unary = nullptr;
+        CoroutineHandler coroutine = nullptr;
+        bool offload = false;
+    };
+    bool registerRoute(const std::string& method, const MethodRoute& route);
+    void buildMethodRoutes();
+    const MethodRoute* findRoute(const uint8_t* data, size_t size) const;
+    static size_t sayHello(Connection* conn, const uint8_t* data, size_t size, WriteTag tag);
+    
+    // Handler offload: the request is copied into a pooled task, encoded on an
+    // executor thread, and the finished frame is queued on the connection by
+    // whichever I/O worker drains the submitting worker's completion queue
+    struct OffloadTask : OffloadedWork {
+        static constexpr size_t REQUEST_CAPACITY = 4096;
+        std::shared_ptr<Connection> conn;
+        WriteTag tag;
+        uint64_t arrival_us = 0;
+        size_t request_size = 0;
+        size_t response_size = 0; // 0 = the handler could not encode a response
+        std::array<uint8_t, REQUEST_CAPACITY> request;
+        std::array<uint8_t, Connection::WRITE_SLOT_SIZE> response;
+    };
+    struct alignas(64) CompletionQueue {
+        MpscQueue<ExecutorTask> tasks;
+        int event_fd = -1;
+        std::atomic<bool> draining{false};
+    };
+    bool offloadRequest(Connection* conn, const uint8_t* data, size_t size, WriteTag tag, uint64_t arrival_us);
+    static void runOffloadedTask(ExecutorTask* base);
+    static void completeOffloadedTask(ExecutorTask* base);
+    int completionWorker(int fd) const;
+    void drainCompletions(int worker_id);
+    std::shared_ptr<Connection> findConnection(int fd);
+    
+    // Coroutine handlers: contexts are indexed by (fd, stream) so DATA frames,
+    // RST_STREAM and connection close reach the handler of their stream
+    friend class HandlerContext;
+    friend struct Handler::promise_type;
+    struct alignas(16) HandlerFrame {
+        unsigned char bytes[1024];
+    };
+    struct HandlerTimer {
+        uint64_t deadline_us;
+        HandlerContext* context;
+        bool operator>(const HandlerTimer& other) const { return deadline_us > other.deadline_us; }
+    };
+    enum class HandlerWrite {
+        Done,
+        Full,
+        Failed
+    };
+    static uint64_t handlerStreamKey(int fd, uint32_t stream_id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(fd)) << 32) | stream_id;
+    }
+    void startHandler(CoroutineHandler handler, Connection* conn, const uint8_t* data, size_t size,
+                      WriteTag tag, uint64_t arrival_us);
+    void releaseHandlerContext(HandlerContext* context);
+    void deliverToHandler(Connection* conn, const uint8_t* data, size_t size);
+    void closeHandlers(int fd, uint32_t stream_id); // stream_id 0 = every stream of fd
+    bool hasHandlers(int fd);
+    HandlerWrite tryHandlerWrite(HandlerContext* context);
+    void scheduleHandlerTimer(HandlerContext* context, uint64_t deadline_us);
+    void fireHandlerTimers();
+    void destroySuspendedHandlers();
     
     // Pre-compiled response templates for common requests
-    std::vector<uint8_t> pre_compiled_hello_response_;
     std::vector<uint8_t> pre_compiled_error_response_;
+    std::vector<uint8_t> pre_compiled_unimplemented_response_; // trailers-only UNIMPLEMENTED
+    std::vector<uint8_t> pre_compiled_overload_response_; // trailers-only RESOURCE_EXHAUSTED
+    std::vector<uint8_t> pre_compiled_deadline_response_; // trailers-only DEADLINE_EXCEEDED
+    std::vector<uint8_t> pre_compiled_ok_trailers_;       // grpc-status 0, ends a handler's stream
     
     // Thread management with CPU affinity
     void epollWorkerThread(int thread_id);
     void cleanupThread();
+    void statsPublisherThread();
+    void publishStats();
+    void recordPerfSample(WorkerStats& worker_stats, const PerfSample& now, PerfSample& last);
     
     // Server configuration optimized for HFT
     static constexpr int MAX_EVENTS = 2048;  // Increased for batch processing
@@ -242,10 +781,41 @@ private:
     static constexpr int CONNECTION_TIMEOUT = 300; // 5 minutes
     static constexpr int CLEANUP_INTERVAL = 60; // 1 minute
     static constexpr int BATCH_SIZE = 64;  // Process events in batches
+    static constexpr int STATS_PUBLISH_INTERVAL_MS = 100; // Shared-memory stats refresh
+    static constexpr int MAX_SHM_SESSIONS = 16;
+    static constexpr int HANDOFF_TIMEOUT_MS = 5000;
+    static constexpr int HANDOFF_SETTLE_MS = 1000; // offloaded requests finishing before a transfer
+    static constexpr int GRPC_STATUS_OK = 0;
+    static constexpr int GRPC_STATUS_DEADLINE_EXCEEDED = 4;
+    static constexpr int GRPC_STATUS_RESOURCE_EXHAUSTED = 8;
+    static constexpr int GRPC_STATUS_UNIMPLEMENTED = 12;
+    static constexpr int HANDOFF_READY_TIMEOUT_MS = 120000; // successor warm-up (mlockall, cache pre-warm)
+    static constexpr uint64_t SHM_IDLE_CHECK_US = 100000; // idle sessions look for client exit/shutdown
     
     // Server state
     int server_socket_;
+    int critical_socket_ = -1;
+    int unix_socket_ = -1;
+    std::string unix_socket_path_;
+    int shm_socket_ = -1;
+    std::string shm_socket_path_;
+    std::vector<std::unique_ptr<ShmSession>> shm_sessions_;
+    std::mutex shm_sessions_mutex_;
+    int shm_sessions_started_ = 0;
+    
+    // Hot restart state
+    int handoff_socket_ = -1;
+    std::string handoff_path_;
+    bool takeover_ = false;
+    bool takeover_connections_ = false;
+    std::thread handoff_thread_;
+    std::atomic<int> handoff_conn_fd_{-1};
+    std::atomic<bool> handoff_in_progress_{false};
+    std::atomic<bool> handed_off_{false};
+    std::atomic<bool> workers_paused_{false};
     int epoll_fd_;
+    int critical_epoll_fd_ = -1; // critical lane, when lanes are on
+    PriorityLaneOptions lanes_;
     std::atomic<bool> running_{false};
     std::string server_address_;
     uint16_t server_port_;
@@ -255,6 +825,7 @@ private:
     std::thread cleanup_thread_;
     std::atomic<bool> cleanup_running_{false};
     std::vector<int> cpu_cores_;  // CPU cores for worker threads
+    std::thread stats_thread_;
     
     // Lock-free connection management
     alignas(64) std::map<int, std::shared_ptr<Connection>> connections_;
@@ -263,6 +834,29 @@ private:
     // Memory pools for zero-allocation operations
     LockFreeMemoryPool<Connection, 10000> connection_pool_;
     
+    // Handler offload (executor threads, in-flight tasks, per-worker completions)
+    static constexpr int MAX_OFFLOAD_TASKS = 1024;
+    OffloadOptions offload_;
+    WorkStealingExecutor executor_;
+    LockFreeMemoryPool<OffloadTask, MAX_OFFLOAD_TASKS> offload_pool_;
+    
+    // Methods by ":path", read-only once the workers run
+    MethodRouter<MethodRoute> method_router_;
+    MethodRoute default_route_; // requests without ":path"
+    size_t coroutine_routes_ = 0;
+    
+    // Coroutine handlers (contexts and frames pooled, one timerfd for sleeps)
+    static constexpr int MAX_COROUTINE_HANDLERS = 1024;
+    static constexpr uint64_t WRITE_RETRY_US = 200;
+    LockFreeMemoryPool<HandlerContext, MAX_COROUTINE_HANDLERS> handler_contexts_;
+    LockFreeMemoryPool<HandlerFrame, MAX_COROUTINE_HANDLERS> handler_frames_;
+    std::multimap<uint64_t, HandlerContext*> handler_streams_;
+    std::mutex handler_mutex_;
+    std::atomic<int> live_handlers_{0};
+    std::vector<HandlerTimer> handler_timers_; // min-heap on deadline_us
+    std::mutex handler_timers_mutex_;
+    int handler_timer_fd_ = -1;
+    
     // Service instances
     std::unique_ptr<HelloServiceImpl> service_;
     
@@ -272,9 +866,45 @@ private:
     // Thread pool configuration optimized for HFT
     static constexpr int NUM_WORKER_THREADS = 8;  // Increased for better parallelism
     
+    // Per-worker statistics and their shared-memory mirror for gRpcSvr_top
+    std::array<WorkerStats, NUM_WORKER_THREADS> worker_stats_;
+    StatsSegment stats_segment_;
+    
+    // One response cache shard per worker, used only by that worker
+    std::array<ResponseCache, NUM_WORKER_THREADS> response_caches_;
+    
+    // Offloaded responses on their way back to the worker that submitted them
+    std::array<CompletionQueue, NUM_WORKER_THREADS> completions_;
+    
+    // One admission controller per worker, fed that worker's queue delays
+    AdmissionController::Options admission_options_;
+    std::array<AdmissionController, NUM_WORKER_THREADS> admission_controllers_;
+    
+    // Hardware counters, degraded to off when perf_event_open is not permitted
+    bool perf_counters_enabled_ = true;
+    std::atomic<int> perf_counters_active_{0};
+    
     // NUMA configuration
     int numa_node_;
     bool numa_available_;
 };
 
-} // namespace hello 
\ No newline at end of file
+template<typename F>
+bool HandlerContext::OffloadAwaiter<F>::await_suspend(std::coroutine_handle<> handle) {
+    this->handle = handle;
+    run = [](ExecutorTask* task) {
+        auto* self = static_cast<OffloadAwaiter*>(task);
+        self->fn();
+        EpollServer::returnToWorker(self);
+    };
+    complete = [](ExecutorTask* task) {
+        static_cast<OffloadAwaiter*>(task)->handle.resume();
+    };
+    if (EpollServer::submitOffload(this)) {
+        return true;
+    }
+    fn();
+    return false;
+}
+
+} // namespace hello
@@ -0,0 +1,189 @@
+#include "EventTrace.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hello {
+
+const char* traceEventName(uint8_t event) {
+    switch (static_cast<TraceEvent>(event)) {
+        case TraceEvent::Accept:       return "ACCEPT";
+        case TraceEvent::Read:         return "READ";
+        case TraceEvent::Parse:        return "PARSE";
+        case TraceEvent::HandlerBegin: return "HANDLER_BEGIN";
+        case TraceEvent::HandlerEnd:   return "HANDLER_END";
+        case TraceEvent::Enqueue:      return "ENQUEUE";
+        case TraceEvent::Send:         return "SEND";
+        case TraceEvent::Close:        return "CLOSE";
+        case TraceEvent::Shed:         return "SHED";
+        case TraceEvent::Expire:       return "EXPIRE";
+        case TraceEvent::Reset:        return "RESET";
+    }
+    return "UNKNOWN";
+}
+
+size_t TraceRing::drain(TraceRecord* out, size_t max_records) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t count = 0;
+
+    while (tail != head && count < max_records) {
+        out[count++] = records_[tail & (CAPACITY - 1)];
+        ++tail;
+    }
+
+    tail_.store(tail, std::memory_order_release);
+    return count;
+}
+
+EventTracer& EventTracer::getInstance() {
+    static EventTracer instance;
+    return instance;
+}
+
+EventTracer::~EventTracer() {
+    stop();
+    for (auto& slot : rings_) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+}
+
+void EventTracer::registerThread(uint8_t worker) {
+    if (t_ring_) {
+        return;
+    }
+
+    int index = ring_count_.fetch_add(1);
+    if (index >= MAX_RINGS) {
+        std::cerr << "EventTracer: too many traced threads, worker " << static_cast<int>(worker)
+                  << " will not be traced" << std::endl;
+        return;
+    }
+
+    // Rings live until process exit so the drain thread never sees a dangling one
+    auto* ring = new TraceRing(worker);
+    rings_[index].store(ring, std::memory_order_release);
+    t_ring_ = ring;
+}
+
+uint64_t EventTracer::recordsDropped() const {
+    uint64_t dropped = 0;
+    for (const auto& slot : rings_) {
+        if (TraceRing* ring = slot.load(std::memory_order_acquire)) {
+            dropped += ring->dropped();
+        }
+    }
+    return dropped;
+}
+
+uint64_t EventTracer::calibrateTscHz() {
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t tsc_start = readTsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t tsc_end = readTsc();
+    auto wall_end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+    return seconds > 0 ? static_cast<uint64_t>((tsc_end - tsc_start) / seconds) : 1000000000ULL;
+}
+
+bool EventTracer::start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (draining_.load()) {
+        std::cout << "EventTracer is already running" << std::endl;
+        return false;
+    }
+
+    file_fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file_fd_ < 0) {
+        std::cerr << "Failed to open trace file " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    TraceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TraceFileHeader::MAGIC;
+    header.version = TraceFileHeader::VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.tsc_hz = calibrateTscHz();
+    header.start_tsc = readTsc();
+    header.start_unix_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (write(file_fd_, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        std::cerr << "Failed to write trace header to " << path << std::endl;
+        close(file_fd_);
+        file_fd_ = -1;
+        return false;
+    }
+
+    records_written_.store(0);
+    draining_.store(true);
+    drain_thread_ = std::thread(&EventTracer::drainThread, this);
+    return true;
+}
+
+void EventTracer::stop() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (!draining_.load()) {
+        return;
+    }
+
+    setEnabled(false);
+    draining_.store(false);
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+
+    if (file_fd_ >= 0) {
+        close(file_fd_);
+        file_fd_ = -1;
+    }
+}
+
+size_t EventTracer::drainOnce() {
+    static thread_local std::vector<TraceRecord> batch(DRAIN_BATCH);
+    size_t total = 0;
+
+    int count = std::min(ring_count_.load(std::memory_order_acquire), MAX_RINGS);
+    for (int i = 0; i < count; ++i) {
+        TraceRing* ring = rings_[i].load(std::memory_order_acquire);
+        if (!ring) continue;
+
+        size_t n;
+        while ((n = ring->drain(batch.data(), batch.size())) > 0) {
+            size_t bytes = n * sizeof(TraceRecord);
+            const char* data = reinterpret_cast<const char*>(batch.data());
+            while (bytes > 0) {
+                ssize_t written = write(file_fd_, data, bytes);
+                if (written <= 0) {
+                    if (errno == EINTR) continue;
+                    std::cerr << "Trace write failed: " << strerror(errno) << std::endl;
+                    return total;
+                }
+                data += written;
+                bytes -= written;
+            }
+            total += n;
+        }
+    }
+
+    records_written_.fetch_add(total, std::memory_order_relaxed);
+    return total;
+}
+
+void EventTracer::drainThread() {
+    while (draining_.load()) {
+        if (drainOnce() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(DRAIN_INTERVAL_US));
+        }
+    }
+    // Flush whatever the workers recorded before tracing was stopped
+    drainOnce();
+}
+
+} // namespace hello
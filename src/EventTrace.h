@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <mutex>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace hello {
+
+// Event types recorded along the epoll request path
+enum class TraceEvent : uint8_t {
+    Accept = 1,
+    Read,
+    Parse,
+    HandlerBegin,
+    HandlerEnd,
+    Enqueue,
+    Send,
+    Close,
+    Shed,         // rejected by admission control; aux = queue delay in us (saturated)
+    Expire,       // past its grpc-timeout before the handler; aux = us late (saturated)
+    Reset,        // RST_STREAM; aux = queued responses cancelled
+};
+
+const char* traceEventName(uint8_t event);
+
+// 16-byte binary record; the file is a TraceFileHeader followed by these
+struct TraceRecord {
+    uint64_t tsc;
+    int32_t fd;
+    uint8_t event;
+    uint8_t worker;
+    uint16_t aux;   // event-specific: byte count (saturated) or frame type
+};
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes");
+
+struct TraceFileHeader {
+    static constexpr uint64_t MAGIC = 0x6752706354726365ULL; // "gRpcTrce"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t tsc_hz;          // ticks per second, calibrated at start
+    uint64_t start_tsc;
+    uint64_t start_unix_ns;   // wall clock at start_tsc
+};
+
+inline uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+// Single-producer/single-consumer ring owned by one worker thread. The producer
+// never blocks: when the drain thread falls behind, records are dropped and counted.
+class TraceRing {
+public:
+    static constexpr size_t CAPACITY = 1 << 16; // 1 MB of records per worker
+
+    explicit TraceRing(uint8_t worker) : worker_(worker) {}
+
+    void push(TraceEvent event, int fd, uint32_t aux) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ >= CAPACITY) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ >= CAPACITY) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        TraceRecord& record = records_[head & (CAPACITY - 1)];
+        record.tsc = readTsc();
+        record.fd = fd;
+        record.event = static_cast<uint8_t>(event);
+        record.worker = worker_;
+        record.aux = aux > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(aux);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Consumer side: copies up to max_records into out, returns the count
+    size_t drain(TraceRecord* out, size_t max_records);
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0;
+    uint8_t worker_;
+    std::atomic<uint64_t> dropped_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::array<TraceRecord, CAPACITY> records_;
+};
+
+// Process-wide tracer: per-thread rings plus one background thread that drains
+// them into a binary file. Recording is switched on and off at runtime; while off,
+// the only cost on the data path is a relaxed load of the enabled flag.
+class EventTracer {
+public:
+    static EventTracer& getInstance();
+
+    EventTracer(const EventTracer&) = delete;
+    EventTracer& operator=(const EventTracer&) = delete;
+
+    bool start(const std::string& path);
+    void stop();
+
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Gives the calling thread its own ring; call once from each worker
+    void registerThread(uint8_t worker);
+
+    uint64_t recordsWritten() const { return records_written_.load(std::memory_order_relaxed); }
+    uint64_t recordsDropped() const;
+
+    static void record(TraceEvent event, int fd, uint32_t aux = 0) {
+        TraceRing* ring = t_ring_;
+        if (ring && isEnabled()) {
+            ring->push(event, fd, aux);
+        }
+    }
+
+private:
+    EventTracer() = default;
+    ~EventTracer();
+
+    void drainThread();
+    size_t drainOnce();
+    static uint64_t calibrateTscHz();
+
+    static constexpr int MAX_RINGS = 64;
+    static constexpr int DRAIN_INTERVAL_US = 500;
+    static constexpr size_t DRAIN_BATCH = 4096;
+
+    static inline thread_local TraceRing* t_ring_ = nullptr;
+    alignas(64) static inline std::atomic<bool> enabled_{false};
+
+    std::array<std::atomic<TraceRing*>, MAX_RINGS> rings_{};
+    std::atomic<int> ring_count_{0};
+    std::mutex start_mutex_;
+
+    int file_fd_ = -1;
+    std::atomic<bool> draining_{false};
+    std::thread drain_thread_;
+    std::atomic<uint64_t> records_written_{0};
+};
+
+} // namespace hello
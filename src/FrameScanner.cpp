@@ -0,0 +1,314 @@
+#include "FrameScanner.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FRAME_SCANNER_X86 1
+#endif
+
+namespace hello {
+
+namespace {
+
+constexpr uint8_t FRAME_DATA = 0;
+constexpr uint8_t FRAME_HEADERS = 1;
+constexpr uint8_t FRAME_CONTINUATION = 9;
+
+// Frame boundaries, following the length chain; also terminates offsets.
+// The length is one 32-bit load and a byte swap, which keeps the chain's
+// per-frame latency down to a load and three ALU operations
+size_t walkFrames(const uint8_t* data, size_t size, FrameBatch& batch) {
+    size_t pos = 0;
+    size_t count = 0;
+    while (count < FrameBatch::MAX_FRAMES && pos + 9 <= size) {
+        uint32_t word;
+        memcpy(&word, data + pos, sizeof(word));
+        size_t length = __builtin_bswap32(word) >> 8;
+        if (pos + 9 + length > size) break;
+        batch.offsets[count++] = static_cast<uint32_t>(pos);
+        pos += 9 + length;
+    }
+    batch.offsets[count] = static_cast<uint32_t>(pos);
+    batch.count = count;
+    return pos;
+}
+
+void extractScalar(const uint8_t* data, FrameBatch& batch, size_t first) {
+    for (size_t i = first; i < batch.count; ++i) {
+        const uint8_t* frame = data + batch.offsets[i];
+        batch.types[i] = frame[3];
+        batch.flags[i] = frame[4];
+        batch.stream_ids[i] = ((static_cast<uint32_t>(frame[5]) << 24) | (frame[6] << 16) |
+                               (frame[7] << 8) | frame[8]) & 0x7FFFFFFF;
+    }
+}
+
+inline bool continuesSegment(const FrameBatch& batch, size_t i) {
+    if (batch.stream_ids[i] != batch.stream_ids[i - 1]) return false;
+    uint8_t type = batch.types[i];
+    uint8_t previous = batch.types[i - 1];
+    return type == FRAME_CONTINUATION ||
+           (type == FRAME_DATA && (previous == FRAME_HEADERS || previous == FRAME_CONTINUATION));
+}
+
+// ORs bits (count of them) into the bit array at position first
+inline void setBits(FrameBatch& batch, size_t first, uint64_t bits) {
+    size_t word = first / 64;
+    size_t shift = first % 64;
+    batch.segment_starts[word] |= bits << shift;
+    if (shift != 0 && word + 1 < batch.segment_starts.size()) {
+        batch.segment_starts[word + 1] |= bits >> (64 - shift);
+    }
+}
+
+void classifyScalar(FrameBatch& batch, size_t first) {
+    for (size_t i = first; i < batch.count; ++i) {
+        if (!continuesSegment(batch, i)) {
+            setBits(batch, i, 1);
+        }
+    }
+}
+
+void clearSegments(FrameBatch& batch) {
+    size_t words = (batch.count + 63) / 64;
+    memset(batch.segment_starts.data(), 0, words * sizeof(uint64_t));
+    if (batch.count > 0) {
+        batch.segment_starts[0] = 1; // the first frame always starts one
+    }
+}
+
+// Value after name on the line at pos; false if it is empty
+bool lineValue(std::string_view block, size_t pos, std::string_view& value) {
+    size_t begin = pos;
+    while (begin < block.size() && block[begin] == ' ') ++begin;
+    size_t end = begin;
+    while (end < block.size() && block[end] != '\r' && block[end] != '\n') ++end;
+    if (end == begin) return false;
+    value = block.substr(begin, end - begin);
+    return true;
+}
+
+inline bool lineMatches(std::string_view block, size_t line, std::string_view name) {
+    return block.size() - line >= name.size() && memcmp(block.data() + line, name.data(), name.size()) == 0;
+}
+
+bool findHeaderScalar(std::string_view block, std::string_view name, size_t from, std::string_view& value) {
+    for (size_t pos = from; pos < block.size(); ++pos) {
+        if (block[pos] == '\n' && lineMatches(block, pos + 1, name)) {
+            return lineValue(block, pos + 1 + name.size(), value);
+        }
+    }
+    return false;
+}
+
+#ifdef FRAME_SCANNER_X86
+
+__attribute__((target("avx2")))
+void extractAvx2(const uint8_t* data, FrameBatch& batch) {
+    // Per 128-bit lane: the 4 type bytes, then the 4 flag bytes
+    const __m256i split = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           0, 4, 8, 12, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i gather_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 3, 6, 7);
+    const __m256i byte_swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i stream_mask = _mm256_set1_epi32(0x7FFFFFFF);
+
+    size_t i = 0;
+    for (; i + 8 <= batch.count; i += 8) {
+        __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.offsets.data() + i));
+        // Bytes 3-6 (type, flags, ...) and 5-8 (stream id) of 8 frame headers
+        __m256i type_flags = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data + 3), offsets, 1);
+        __m256i stream = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data + 5), offsets, 1);
+
+        stream = _mm256_and_si256(_mm256_shuffle_epi8(stream, byte_swap), stream_mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(batch.stream_ids.data() + i), stream);
+
+        __m128i packed = _mm256_castsi256_si128(
+            _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(type_flags, split), gather_order));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(batch.types.data() + i), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(batch.flags.data() + i), _mm_srli_si128(packed, 8));
+    }
+    extractScalar(data, batch, i);
+}
+
+__attribute__((target("avx2")))
+void classifyAvx2(FrameBatch& batch) {
+    const __m256i data_type = _mm256_set1_epi32(FRAME_DATA);
+    const __m256i headers_type = _mm256_set1_epi32(FRAME_HEADERS);
+    const __m256i continuation_type = _mm256_set1_epi32(FRAME_CONTINUATION);
+
+    // Frame i is compared with frame i - 1, so vectors start at frame 1
+    size_t i = 1;
+    for (; i + 8 <= batch.count; i += 8) {
+        __m256i stream = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.stream_ids.data() + i));
+        __m256i previous_stream = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.stream_ids.data() + i - 1));
+        __m256i type = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(batch.types.data() + i)));
+        __m256i previous = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(batch.types.data() + i - 1)));
+
+        __m256i after_headers = _mm256_or_si256(_mm256_cmpeq_epi32(previous, headers_type),
+                                                _mm256_cmpeq_epi32(previous, continuation_type));
+        __m256i continues = _mm256_or_si256(_mm256_cmpeq_epi32(type, continuation_type),
+                                            _mm256_and_si256(_mm256_cmpeq_epi32(type, data_type), after_headers));
+        continues = _mm256_and_si256(continues, _mm256_cmpeq_epi32(stream, previous_stream));
+
+        uint64_t starts = ~static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(continues))) & 0xFF;
+        setBits(batch, i, starts);
+    }
+    classifyScalar(batch, i);
+}
+
+__attribute__((target("sse4.2")))
+void classifySse42(FrameBatch& batch) {
+    const __m128i data_type = _mm_set1_epi32(FRAME_DATA);
+    const __m128i headers_type = _mm_set1_epi32(FRAME_HEADERS);
+    const __m128i continuation_type = _mm_set1_epi32(FRAME_CONTINUATION);
+
+    size_t i = 1;
+    for (; i + 4 <= batch.count; i += 4) {
+        int32_t types;
+        int32_t previous_types;
+        memcpy(&types, batch.types.data() + i, sizeof(types));
+        memcpy(&previous_types, batch.types.data() + i - 1, sizeof(previous_types));
+        __m128i stream = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.stream_ids.data() + i));
+        __m128i previous_stream = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.stream_ids.data() + i - 1));
+        __m128i type = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(types));
+        __m128i previous = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(previous_types));
+
+        __m128i after_headers = _mm_or_si128(_mm_cmpeq_epi32(previous, headers_type),
+                                             _mm_cmpeq_epi32(previous, continuation_type));
+        __m128i continues = _mm_or_si128(_mm_cmpeq_epi32(type, continuation_type),
+                                         _mm_and_si128(_mm_cmpeq_epi32(type, data_type), after_headers));
+        continues = _mm_and_si128(continues, _mm_cmpeq_epi32(stream, previous_stream));
+
+        uint64_t starts = ~static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(continues))) & 0xF;
+        setBits(batch, i, starts);
+    }
+    classifyScalar(batch, i);
+}
+
+// Line starts whose first byte is name's: a newline at pos and the first
+// byte at pos + 1, 32 positions per compare pair
+__attribute__((target("avx2")))
+bool findHeaderAvx2(std::string_view block, std::string_view name, std::string_view& value) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i first = _mm256_set1_epi8(name[0]);
+    const char* bytes = block.data();
+
+    size_t pos = 0;
+    for (; pos + 33 <= block.size(); pos += 32) {
+        __m256i here = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + pos));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + pos + 1));
+        uint32_t candidates = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(here, newline), _mm256_cmpeq_epi8(next, first))));
+        while (candidates) {
+            size_t line = pos + __builtin_ctz(candidates) + 1;
+            if (lineMatches(block, line, name)) {
+                return lineValue(block, line + name.size(), value);
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    return findHeaderScalar(block, name, pos, value);
+}
+
+__attribute__((target("sse4.2")))
+bool findHeaderSse42(std::string_view block, std::string_view name, std::string_view& value) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i first = _mm_set1_epi8(name[0]);
+    const char* bytes = block.data();
+
+    size_t pos = 0;
+    for (; pos + 17 <= block.size(); pos += 16) {
+        __m128i here = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos + 1));
+        uint32_t candidates = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(here, newline), _mm_cmpeq_epi8(next, first))));
+        while (candidates) {
+            size_t line = pos + __builtin_ctz(candidates) + 1;
+            if (lineMatches(block, line, name)) {
+                return lineValue(block, line + name.size(), value);
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    return findHeaderScalar(block, name, pos, value);
+}
+
+#endif // FRAME_SCANNER_X86
+
+} // namespace
+
+FrameScanner::FrameScanner() : isa_(detect()) {}
+
+FrameScanner::FrameScanner(Isa isa) : isa_(supported(isa) ? isa : detect()) {}
+
+FrameScanner::Isa FrameScanner::detect() {
+    if (supported(Isa::Avx2)) return Isa::Avx2;
+    if (supported(Isa::Sse42)) return Isa::Sse42;
+    return Isa::Scalar;
+}
+
+bool FrameScanner::supported(Isa isa) {
+    switch (isa) {
+#ifdef FRAME_SCANNER_X86
+        case Isa::Avx2: return __builtin_cpu_supports("avx2");
+        case Isa::Sse42: return __builtin_cpu_supports("sse4.2");
+#else
+        case Isa::Avx2:
+        case Isa::Sse42: return false;
+#endif
+        case Isa::Scalar: return true;
+    }
+    return false;
+}
+
+const char* FrameScanner::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Avx2: return "avx2";
+        case Isa::Sse42: return "sse4.2";
+        case Isa::Scalar: return "scalar";
+    }
+    return "unknown";
+}
+
+size_t FrameScanner::scan(const uint8_t* data, size_t size, FrameBatch& batch) const {
+    size_t consumed = walkFrames(data, size, batch);
+    clearSegments(batch);
+
+    switch (isa_) {
+#ifdef FRAME_SCANNER_X86
+        case Isa::Avx2:
+            extractAvx2(data, batch);
+            classifyAvx2(batch);
+            break;
+        case Isa::Sse42:
+            extractScalar(data, batch, 0);
+            classifySse42(batch);
+            break;
+#endif
+        default:
+            extractScalar(data, batch, 0);
+            classifyScalar(batch, 1);
+            break;
+    }
+    return consumed;
+}
+
+bool FrameScanner::findHeaderLine(std::string_view block, std::string_view name, std::string_view& value) const {
+    if (name.empty()) return false;
+
+    // The first line has no newline in front of it
+    if (lineMatches(block, 0, name)) {
+        return lineValue(block, name.size(), value);
+    }
+
+    switch (isa_) {
+#ifdef FRAME_SCANNER_X86
+        case Isa::Avx2: return findHeaderAvx2(block, name, value);
+        case Isa::Sse42: return findHeaderSse42(block, name, value);
+#endif
+        default: return findHeaderScalar(block, name, 0, value);
+    }
+}
+
+} // namespace hello
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace hello {
+
+// Frames found in one receive batch, as parallel arrays rather than frame
+// structs so the vector passes load 8 stream ids or 32 types at a time.
+// Frame i spans [offsets[i], offsets[i + 1]) of the scanned bytes.
+struct FrameBatch {
+    static constexpr size_t MAX_FRAMES = 2048; // a 16 KB read of empty frames fits
+
+    size_t count = 0;
+    alignas(64) std::array<uint32_t, MAX_FRAMES + 1> offsets;
+    alignas(64) std::array<uint32_t, MAX_FRAMES> stream_ids;
+    alignas(64) std::array<uint8_t, MAX_FRAMES> types;
+    alignas(64) std::array<uint8_t, MAX_FRAMES> flags;
+
+    // Bit i set: frame i begins a request segment (see FrameScanner::scan)
+    alignas(64) std::array<uint64_t, MAX_FRAMES / 64> segment_starts;
+
+    bool startsSegment(size_t i) const { return (segment_starts[i / 64] >> (i % 64)) & 1; }
+};
+
+// Splits pipelined HTTP/2 input into frames and request segments.
+//
+// Frame boundaries form a chain (each length says where the next header
+// is), so the walk itself stays a tight scalar loop of one load per frame.
+// Everything after it is vectorized: with AVX2 the type, flags and stream
+// id of 8 frames come out of one pair of gathers, and segment starts are
+// computed 8 frames per compare (4 with SSE4.2). Header blocks are searched
+// line by line from a vector newline scan instead of with repeated
+// substring searches. The widest instruction set the CPU supports is picked
+// at startup. Scalar is the fallback and also the reference the benchmark
+// checks the others against.
+class FrameScanner {
+public:
+    enum class Isa {
+        Scalar,
+        Sse42,
+        Avx2
+    };
+
+    // Best supported instruction set
+    FrameScanner();
+    explicit FrameScanner(Isa isa);
+
+    static Isa detect();
+    static bool supported(Isa isa);
+    static const char* isaName(Isa isa);
+    Isa isa() const { return isa_; }
+
+    // Records the complete frames at the start of data into batch and marks
+    // the frames that begin a request segment: every frame except a
+    // CONTINUATION, or the first DATA after HEADERS/CONTINUATION, on the
+    // stream of the frame before it. Returns the bytes the recorded frames
+    // cover; anything after is an incomplete frame, or frames past
+    // MAX_FRAMES for the next call.
+    size_t scan(const uint8_t* data, size_t size, FrameBatch& batch) const;
+
+    // Value of the "name: value\r\n" line whose name (including the colon)
+    // is name, with leading spaces skipped; false if there is none or it is
+    // empty
+    bool findHeaderLine(std::string_view block, std::string_view name, std::string_view& value) const;
+
+private:
+    Isa isa_;
+};
+
+} // namespace hello
@@ -0,0 +1,84 @@
+#include "GreetingFormatter.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace hello {
+
+namespace {
+
+constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Per-thread output buffer; grows to the longest greeting seen, never shrinks
+thread_local std::string t_buffer;
+
+char* reserveBuffer(size_t size) {
+    if (t_buffer.size() < size) {
+        t_buffer.resize(std::max<size_t>(size, 256));
+    }
+    return t_buffer.data();
+}
+
+char* append(char* out, std::string_view text) {
+    memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
+char* appendGreeting(char* out, std::string_view name, int32_t age) {
+    out = append(out, GreetingFormatter::PREFIX);
+    out = append(out, name);
+    out = append(out, GreetingFormatter::MIDDLE);
+    out = GreetingFormatter::formatInt(out, age);
+    return append(out, GreetingFormatter::SUFFIX);
+}
+
+} // namespace
+
+char* GreetingFormatter::formatInt(char* out, int32_t value) {
+    uint32_t magnitude = static_cast<uint32_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    // Fill from the back, two digits per division
+    char digits[10];
+    char* p = digits + sizeof(digits);
+    while (magnitude >= 100) {
+        uint32_t pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (magnitude >= 10) {
+        *--p = DIGIT_PAIRS[magnitude * 2 + 1];
+        *--p = DIGIT_PAIRS[magnitude * 2];
+    } else {
+        *--p = static_cast<char>('0' + magnitude);
+    }
+
+    size_t count = digits + sizeof(digits) - p;
+    memcpy(out, p, count);
+    return out + count;
+}
+
+std::string_view GreetingFormatter::greeting(std::string_view name, int32_t age) {
+    char* begin = reserveBuffer(LITERAL_SIZE + name.size() + MAX_INT_DIGITS);
+    char* end = appendGreeting(begin, name, age);
+    return std::string_view(begin, end - begin);
+}
+
+std::string_view GreetingFormatter::streamGreeting(std::string_view name, int32_t age, int32_t index) {
+    char* begin = reserveBuffer(LITERAL_SIZE + name.size() + MAX_INT_DIGITS +
+                                STREAM_PREFIX.size() + MAX_INT_DIGITS + STREAM_SUFFIX.size());
+    char* end = appendGreeting(begin, name, age);
+    end = append(end, STREAM_PREFIX);
+    end = formatInt(end, index);
+    end = append(end, STREAM_SUFFIX);
+    return std::string_view(begin, end - begin);
+}
+
+} // namespace hello
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace hello {
+
+// Builds the SayHello greeting text without temporaries. The literal parts are
+// split at compile time around the name and age slots, integers go through a
+// two-digits-per-step formatter, and the text is assembled in a thread-local
+// buffer that keeps its capacity, so a thread only allocates when it sees a
+// longer greeting than any before.
+class GreetingFormatter {
+public:
+    static constexpr std::string_view PREFIX = "Hello, ";
+    static constexpr std::string_view MIDDLE = "! You are ";
+    static constexpr std::string_view SUFFIX = " years old. Welcome to gRPC!";
+    static constexpr std::string_view STREAM_PREFIX = " (stream message ";
+    static constexpr std::string_view STREAM_SUFFIX = ")";
+
+    static constexpr size_t LITERAL_SIZE = PREFIX.size() + MIDDLE.size() + SUFFIX.size();
+    static constexpr size_t MAX_INT_DIGITS = 11; // "-2147483648"
+
+    // Writes value in decimal to out, which must hold MAX_INT_DIGITS bytes;
+    // returns the end of the digits
+    static char* formatInt(char* out, int32_t value);
+
+    // "Hello, <name>! You are <age> years old. Welcome to gRPC!"
+    // The view points into the calling thread's buffer and is valid until the
+    // thread's next greeting() / streamGreeting() call.
+    static std::string_view greeting(std::string_view name, int32_t age);
+
+    // greeting() followed by " (stream message <index>)"
+    static std::string_view streamGreeting(std::string_view name, int32_t age, int32_t index);
+};
+
+} // namespace hello
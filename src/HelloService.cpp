@@ -1,8 +1,11 @@
 #include "HelloService.h"
+#include "GreetingFormatter.h"
 #include <iostream>
 #include <sstream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <grpcpp/alarm.h>
 
 namespace hello {
 
@@ -13,72 +16,224 @@ grpc::Status HelloServiceImpl::SayHello(grpc::ServerContext* /*context*/,
     // std::cout << "SayHello called with name: " << request->name() 
     //           << ", age: " << request->age() << std::endl;
     
-    // Optimized: Pre-allocate string capacity
-    std::string message;
-    message.reserve(100); // Pre-allocate space for typical response
-    
-    // Optimized: Use string concatenation instead of ostringstream for better performance
-    message = "Hello, ";
-    message += request->name();
-    message += "! You are ";
-    message += std::to_string(request->age());
-    message += " years old. Welcome to gRPC!";
-    
-    response->set_message(std::move(message));
-    
-    // Optimized: Use high_resolution_clock for more precise timing
-    response->set_timestamp(std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+    buildHelloResponse(*request, response);
     
     return grpc::Status::OK;
 }
 
-grpc::Status HelloServiceImpl::SayHelloStream(grpc::ServerContext* /*context*/, 
+grpc::Status HelloServiceImpl::SayHelloStream(grpc::ServerContext* context, 
                                              const HelloRequest* request, 
                                              grpc::ServerWriter<HelloResponse>* writer) {
-    // Optimized: Remove console output for better performance
-    // std::cout << "SayHelloStream called with name: " << request->name() 
-    //           << ", age: " << request->age() << std::endl;
+    // Message k is due at start + (k - 1) * interval, the reactor's schedule,
+    // so a late wakeup does not push back the messages after it
+    const int32_t count = pacing_.countFor(*request);
+    const std::chrono::milliseconds interval = pacing_.intervalFor(*request);
+    const auto start = std::chrono::steady_clock::now();
     
-    // Optimized: Pre-allocate response object and reuse it
     HelloResponse response;
-    std::string baseMessage;
-    baseMessage.reserve(100);
-    baseMessage = "Hello, ";
-    baseMessage += request->name();
-    baseMessage += "! You are ";
-    baseMessage += std::to_string(request->age());
-    baseMessage += " years old. Welcome to gRPC!";
-    
-    for (int i = 0; i < 5; ++i) {
-        // Optimized: Reuse the same response object
-        std::string message = baseMessage + " (stream message " + std::to_string(i + 1) + ")";
-        response.set_message(std::move(message));
-        response.set_timestamp(std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+    for (int32_t sent = 1; sent <= count; ++sent) {
+        if (sent > 1 && !waitUntilDue(context, start + interval * (sent - 1))) {
+            return grpc::Status::CANCELLED;
+        }
+        buildStreamResponse(*request, sent, &response);
         
-        if (!writer->Write(response)) {
-            std::cerr << "Failed to write stream response" << std::endl;
+        // The last message is held back and flushed with the trailing status
+        grpc::WriteOptions options;
+        if (sent == count) {
+            options.set_last_message();
+        }
+        if (!writer->Write(response, options)) {
             return grpc::Status(grpc::StatusCode::INTERNAL, "Failed to write stream");
         }
-        
-        // Optimized: Reduce sleep time for faster streaming
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
     return grpc::Status::OK;
 }
 
-std::string HelloServiceImpl::generateResponse(const std::string& name, int32_t age) {
-    // Optimized: Use string concatenation instead of ostringstream
-    std::string response;
-    response.reserve(100);
-    response = "Hello, ";
-    response += name;
-    response += "! You are ";
-    response += std::to_string(age);
-    response += " years old. Welcome to gRPC!";
-    return response;
+bool HelloServiceImpl::waitUntilDue(grpc::ServerContext* context, std::chrono::steady_clock::time_point due) {
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    while (!streamsStopped_ && !context->IsCancelled()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= due) {
+            return true;
+        }
+        streamWake_.wait_until(lock, std::min(due, now + CANCEL_CHECK));
+    }
+    return false;
+}
+
+void HelloServiceImpl::stopStreams() {
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        streamsStopped_ = true;
+    }
+    streamWake_.notify_all();
+}
+
+void HelloServiceImpl::buildHelloResponse(const HelloRequest& request, HelloResponse* response,
+                                          ClockSource clock) {
+    std::string_view text = GreetingFormatter::greeting(request.name(), request.age());
+    response->mutable_message()->assign(text.data(), text.size());
+    response->set_timestamp(timestampMicros(clock));
+}
+
+void HelloServiceImpl::buildStreamResponse(const HelloRequest& request, int32_t index, HelloResponse* response,
+                                           ClockSource clock) {
+    std::string_view text = GreetingFormatter::streamGreeting(request.name(), request.age(), index);
+    response->mutable_message()->assign(text.data(), text.size());
+    response->set_timestamp(timestampMicros(clock));
+}
+
+HelloServiceArenaImpl::HelloServiceArenaImpl() {
+    SetMessageAllocatorFor_SayHello(&allocator_);
+}
+
+grpc::ServerUnaryReactor* HelloServiceArenaImpl::SayHello(grpc::CallbackServerContext* context,
+                                                          const HelloRequest* request,
+                                                          HelloResponse* response) {
+    // Runs inline on the gRPC callback thread; the default reactor needs no allocation
+    buildHelloResponse(*request, response);
+    
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
+
+int32_t StreamPacing::countFor(const HelloRequest& request) const {
+    return countFor(request.has_stream_count() ? std::optional<int32_t>(request.stream_count()) : std::nullopt);
+}
+
+std::chrono::milliseconds StreamPacing::intervalFor(const HelloRequest& request) const {
+    return intervalFor(request.has_stream_interval_ms() ? std::optional<int32_t>(request.stream_interval_ms())
+                                                        : std::nullopt);
+}
+
+int32_t StreamPacing::countFor(std::optional<int32_t> requested) const {
+    if (!requested) {
+        return count;
+    }
+    return std::clamp(*requested, 0, max_count);
+}
+
+std::chrono::milliseconds StreamPacing::intervalFor(std::optional<int32_t> requested_ms) const {
+    if (!requested_ms) {
+        return interval;
+    }
+    return std::clamp(std::chrono::milliseconds(*requested_ms), std::chrono::milliseconds::zero(), max_interval);
+}
+
+namespace {
+
+// Writes message k of the stream at start + k * interval, driven by an alarm
+// instead of a sleeping thread. Messages that are due together (zero interval,
+// or a late timer) are chained from OnWriteDone without waiting, so the
+// transport batches them into shared flushes. The last message goes out with
+// WriteLast and is flushed together with the trailing status. No buffer hint is
+// used: a hinted write does not complete until something else flushes it, so
+// the next chained write would stall behind it.
+class HelloStreamReactor final : public grpc::ServerWriteReactor<HelloResponse> {
+public:
+    // request is owned by gRPC and outlives the reactor
+    HelloStreamReactor(const HelloRequest& request, const StreamPacing& pacing)
+        : request_(request),
+          count_(pacing.countFor(request)),
+          interval_(pacing.intervalFor(request)),
+          start_(std::chrono::system_clock::now()) {
+        if (count_ == 0) {
+            Finish(grpc::Status::OK);
+        } else {
+            writeDue();
+        }
+    }
+    
+    void OnWriteDone(bool ok) override {
+        if (!ok) {
+            Finish(grpc::Status(grpc::StatusCode::INTERNAL, "Failed to write stream"));
+            return;
+        }
+        if (sent_ == count_) {
+            Finish(grpc::Status::OK);
+            return;
+        }
+        if (sent_ < due_) {
+            writeNext();
+            return;
+        }
+        alarm_.Set(start_ + interval_ * sent_, [this](bool fired) {
+            if (fired) {
+                writeDue();
+            } else {
+                Finish(grpc::Status::CANCELLED);
+            }
+        });
+    }
+    
+    void OnCancel() override {
+        // Wakes a pending pause early; its callback then finishes the stream
+        alarm_.Cancel();
+    }
+    
+    void OnDone() override {
+        delete this;
+    }
+
+private:
+    void writeDue() {
+        if (interval_.count() == 0) {
+            due_ = count_;
+        } else {
+            auto elapsed = std::chrono::system_clock::now() - start_;
+            int64_t reached = elapsed / interval_ + 1;
+            due_ = static_cast<int32_t>(std::min<int64_t>(reached, count_));
+        }
+        writeNext();
+    }
+    
+    void writeNext() {
+        ++sent_;
+        HelloServiceImpl::buildStreamResponse(request_, sent_, &response_);
+        
+        if (sent_ == count_) {
+            StartWriteLast(&response_, grpc::WriteOptions());
+        } else {
+            StartWrite(&response_);
+        }
+    }
+    
+    const HelloRequest& request_;
+    const int32_t count_;
+    const std::chrono::milliseconds interval_;
+    const std::chrono::system_clock::time_point start_;
+    int32_t sent_ = 0;
+    int32_t due_ = 0;
+    HelloResponse response_;
+    grpc::Alarm alarm_;
+};
+
+} // namespace
+
+grpc::ServerWriteReactor<HelloResponse>* HelloServiceImpl::startStream(const HelloRequest& request,
+                                                                       const StreamPacing& pacing) {
+    return new HelloStreamReactor(request, pacing);
+}
+
+HelloServiceCallbackImpl::HelloServiceCallbackImpl() {
+    SetMessageAllocatorFor_SayHello(&allocator_);
+}
+
+grpc::ServerUnaryReactor* HelloServiceCallbackImpl::SayHello(grpc::CallbackServerContext* context,
+                                                             const HelloRequest* request,
+                                                             HelloResponse* response) {
+    HelloServiceImpl::buildHelloResponse(*request, response);
+    
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
+
+grpc::ServerWriteReactor<HelloResponse>* HelloServiceCallbackImpl::SayHelloStream(
+        grpc::CallbackServerContext* /*context*/, const HelloRequest* request) {
+    return HelloServiceImpl::startStream(*request, pacing_);
 }
 
 } // namespace hello 
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <memory>
 #include <string>
 #include <chrono>
+#include <optional>
+#include <mutex>
+#include <condition_variable>
 
 // Forward declarations
 namespace hello {
@@ -12,10 +15,33 @@ namespace hello {
 
 // Generated protobuf includes
 #include "HelloService.grpc.pb.h"
+#include "ArenaMessageAllocator.h"
+#include "CoarseClock.h"
 
 namespace hello {
 
-class HelloServiceImpl final : public HelloService::Service {
+// Shape of a SayHelloStream: how many messages and how far apart. Requests may
+// override both through stream_count / stream_interval_ms, clamped to the limits
+struct StreamPacing {
+    int32_t count = 5;
+    std::chrono::milliseconds interval{100};
+    int32_t max_count = 1000;
+    std::chrono::milliseconds max_interval{10000};
+    
+    int32_t countFor(const HelloRequest& request) const;
+    std::chrono::milliseconds intervalFor(const HelloRequest& request) const;
+    
+    // The same for fields read without protobuf (the epoll server's own
+    // parser); nullopt when the request leaves the field unset
+    int32_t countFor(std::optional<int32_t> requested) const;
+    std::chrono::milliseconds intervalFor(std::optional<int32_t> requested_ms) const;
+};
+
+// Plain synchronous service: both handlers run on grpc++'s handler threads.
+// SayHelloStream keeps its thread for the whole stream, but waits for each
+// message's slot on a condition variable rather than sleeping, so a cancelled
+// call or a stopping server ends it at once
+class HelloServiceImpl : public HelloService::Service {
 public:
     grpc::Status SayHello(grpc::ServerContext* context, 
                          const HelloRequest* request, 
@@ -24,9 +50,74 @@ public:
     grpc::Status SayHelloStream(grpc::ServerContext* context, 
                                const HelloRequest* request, 
                                grpc::ServerWriter<HelloResponse>* writer) override;
+    
+    // Applies to streams started after the call; set before registering the service
+    void setStreamPacing(const StreamPacing& pacing) { pacing_ = pacing; }
+    
+    // Wakes every paused stream and ends it; call before shutting the server down
+    void stopStreams();
+
+    // Fill response in place from GreetingFormatter's thread-local buffer; a
+    // reused response keeps its message capacity, so refilling it does not
+    // allocate. On an arena the message string object lives there too. The
+    // timestamp comes from CoarseClock unless the call site asks for Precise
+    static void buildHelloResponse(const HelloRequest& request, HelloResponse* response,
+                                   ClockSource clock = ClockSource::Cached);
+    static void buildStreamResponse(const HelloRequest& request, int32_t index, HelloResponse* response,
+                                    ClockSource clock = ClockSource::Cached);
+
+    // Paced write reactor shared by every callback SayHelloStream
+    static grpc::ServerWriteReactor<HelloResponse>* startStream(const HelloRequest& request,
+                                                                const StreamPacing& pacing);
+
+private:
+    // IsCancelled() has no notification in the sync API, so a pause re-checks
+    // it at least this often
+    static constexpr std::chrono::milliseconds CANCEL_CHECK{50};
+    
+    // False if the call was cancelled or the streams stopped before due
+    bool waitUntilDue(grpc::ServerContext* context, std::chrono::steady_clock::time_point due);
+    
+    StreamPacing pacing_;
+    std::mutex streamMutex_;
+    std::condition_variable streamWake_;
+    bool streamsStopped_ = false;
+};
+
+// SayHello on the callback API with pooled per-RPC arenas for request and
+// response; the synchronous SayHelloStream is inherited unchanged
+class HelloServiceArenaImpl final : public HelloService::WithCallbackMethod_SayHello<HelloServiceImpl> {
+public:
+    HelloServiceArenaImpl();
+    
+    grpc::ServerUnaryReactor* SayHello(grpc::CallbackServerContext* context,
+                                       const HelloRequest* request,
+                                       HelloResponse* response) override;
+
+private:
+    ArenaMessageAllocator allocator_;
+};
+
+// Whole service on the callback API. Both handlers run inline on gRPC's
+// event-engine threads: SayHello finishes its default reactor before
+// returning, and SayHelloStream is a write reactor paced by alarms, so no RPC
+// ever occupies a thread while it waits
+class HelloServiceCallbackImpl final : public HelloService::CallbackService {
+public:
+    HelloServiceCallbackImpl();
+    
+    void setStreamPacing(const StreamPacing& pacing) { pacing_ = pacing; }
+    
+    grpc::ServerUnaryReactor* SayHello(grpc::CallbackServerContext* context,
+                                       const HelloRequest* request,
+                                       HelloResponse* response) override;
+    
+    grpc::ServerWriteReactor<HelloResponse>* SayHelloStream(grpc::CallbackServerContext* context,
+                                                            const HelloRequest* request) override;
 
 private:
-    std::string generateResponse(const std::string& name, int32_t age);
+    ArenaMessageAllocator allocator_;
+    StreamPacing pacing_;
 };
 
 } // namespace hello 
\ No newline at end of file
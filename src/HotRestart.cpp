@@ -0,0 +1,112 @@
+#include "HotRestart.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hello {
+
+bool sendHandoff(int socket_fd, HandoffMessage::Type type, uint32_t flags,
+                 const int* fds, const uint8_t* kinds, size_t count) {
+    if (count > HandoffMessage::MAX_FDS) {
+        return false;
+    }
+
+    HandoffMessage message;
+    message.type = type;
+    message.flags = flags;
+    message.count = static_cast<uint32_t>(count);
+    if (kinds) {
+        memcpy(message.kinds, kinds, count);
+    }
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    struct iovec iov = {&message, sizeof(message)};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * HandoffMessage::MAX_FDS)];
+    if (count > 0) {
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+    }
+
+    return sendmsg(socket_fd, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(message));
+}
+
+bool receiveHandoff(int socket_fd, HandoffMessage& message, int* fds, int timeout_ms) {
+    struct pollfd pfd = {socket_fd, POLLIN, 0};
+    int ready;
+    while ((ready = poll(&pfd, 1, timeout_ms)) < 0 && errno == EINTR) {
+    }
+    if (ready <= 0) {
+        return false;
+    }
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    struct iovec iov = {&message, sizeof(message)};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * HandoffMessage::MAX_FDS)];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(socket_fd, &msg, MSG_CMSG_CLOEXEC);
+    if (received <= 0) {
+        return false;
+    }
+
+    size_t fd_count = 0;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            fd_count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * fd_count);
+        }
+    }
+
+    bool valid = received == static_cast<ssize_t>(sizeof(message)) && !(msg.msg_flags & MSG_CTRUNC) &&
+                 message.magic == HandoffMessage::MAGIC && message.version == HandoffMessage::VERSION &&
+                 message.count == fd_count;
+    if (!valid) {
+        std::cerr << "Malformed hot-restart handoff message" << std::endl;
+        for (size_t i = 0; i < fd_count; ++i) {
+            close(fds[i]);
+        }
+        return false;
+    }
+    return true;
+}
+
+int connectHandoff(const std::string& path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace hello
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace hello {
+
+// Hot-restart handoff between a running EpollServer and its successor, over
+// an AF_UNIX SOCK_SEQPACKET socket (one message per send, descriptors riding
+// along as SCM_RIGHTS):
+//
+//   successor                       running server
+//   Request{flags}          ->
+//                           <-      Listeners{kinds[]} + listening sockets
+//   (warm up, start workers)
+//   Ready                   ->      stops accepting, starts draining
+//                           <-      Connections{count} + sockets   (if requested)
+//                           <-      Done
+//
+// A successor that dies before Ready leaves the running server untouched.
+struct HandoffMessage {
+    static constexpr uint32_t MAGIC = 0x48616e64; // "Hand"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t MAX_FDS = 64;
+
+    enum Type : uint16_t {
+        Request = 1,
+        Listeners = 2,
+        Ready = 3,
+        Connections = 4,
+        Done = 5
+    };
+
+    // Request flags
+    static constexpr uint32_t WANT_CONNECTIONS = 1;
+
+    // Listener kinds, in the order the descriptors are attached
+    enum Kind : uint8_t {
+        TcpListener = 0,
+        UnixListener = 1,
+        ShmListener = 2,
+        CriticalTcpListener = 3 // priority-lane listener
+    };
+    static constexpr size_t LISTENER_KINDS = 4;
+
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    uint16_t type = 0;
+    uint32_t flags = 0;
+    uint32_t count = 0; // descriptors attached
+    uint8_t kinds[MAX_FDS] = {};
+};
+
+// Sends message with count descriptors from fds attached
+bool sendHandoff(int socket_fd, HandoffMessage::Type type, uint32_t flags = 0,
+                 const int* fds = nullptr, const uint8_t* kinds = nullptr, size_t count = 0);
+
+// Waits up to timeout_ms for the next message; fds receives message.count
+// descriptors (closed on error). Returns false on timeout, EOF or a bad message.
+bool receiveHandoff(int socket_fd, HandoffMessage& message, int* fds, int timeout_ms);
+
+// Successor side; -1 when no server is listening at path
+int connectHandoff(const std::string& path);
+
+} // namespace hello
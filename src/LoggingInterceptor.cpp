@@ -1,62 +1,106 @@
 #include "LoggingInterceptor.h"
-#include <iostream>
-#include <iomanip>
-#include <sstream>
+#include "AsyncLogger.h"
 
 namespace hello {
 
-LoggingInterceptor::LoggingInterceptor(grpc::experimental::ServerRpcInfo* info) 
-    : info_(info), startTime_(std::chrono::steady_clock::now()) {
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+LoggingInterceptor::LoggingInterceptor(grpc::experimental::ServerRpcInfo* info, Mode mode,
+                                       bool logErrors, uint64_t slowThresholdUs)
+    : info_(info), startTime_(std::chrono::steady_clock::now()), mode_(mode),
+      logErrors_(logErrors), slowThresholdUs_(slowThresholdUs) {
 }
 
 void LoggingInterceptor::Intercept(grpc::experimental::InterceptorBatchMethods* methods) {
-    if (methods->QueryInterceptionHookPoint(grpc::experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA)) {
+    if (mode_ == Mode::Full &&
+        methods->QueryInterceptionHookPoint(grpc::experimental::InterceptionHookPoints::PRE_SEND_INITIAL_METADATA)) {
         logRequest(info_->method());
     }
     
-    if (methods->QueryInterceptionHookPoint(grpc::experimental::InterceptionHookPoints::POST_SEND_MESSAGE)) {
-        // Log after sending message
-    }
-    
     if (methods->QueryInterceptionHookPoint(grpc::experimental::InterceptionHookPoints::PRE_SEND_STATUS)) {
         grpc::Status status = methods->GetSendStatus();
-        logResponse(info_->method(), status);
+        uint64_t durationUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime_).count();
+        
+        if (mode_ == Mode::Full ||
+            (logErrors_ && !status.ok()) ||
+            (slowThresholdUs_ > 0 && durationUs >= slowThresholdUs_)) {
+            logResponse(info_->method(), status, durationUs);
+        }
     }
     
     methods->Proceed();
 }
 
-void LoggingInterceptor::logRequest(const std::string& methodName) {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto tm = *std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    std::cout << "[" << oss.str() << "] REQUEST: " << methodName << std::endl;
+// Both hooks only enqueue a binary record; AsyncLogger formats and writes it
+void LoggingInterceptor::logRequest(const char* methodName) {
+    AsyncLogger::getInstance().logRequest(methodName);
 }
 
-void LoggingInterceptor::logResponse(const std::string& methodName, grpc::Status status) {
-    auto endTime = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime_);
-    
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto tm = *std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    std::string statusStr = status.ok() ? "OK" : "ERROR";
-    std::cout << "[" << oss.str() << "] RESPONSE: " << methodName 
-              << " - Status: " << statusStr 
-              << " - Duration: " << duration.count() << "ms" << std::endl;
+void LoggingInterceptor::logResponse(const char* methodName, const grpc::Status& status, uint64_t durationUs) {
+    AsyncLogger::getInstance().logResponse(methodName, status.error_code(), durationUs);
+}
+
+LoggingInterceptorFactory::LoggingInterceptorFactory(const LoggingPolicy& policy)
+    : policy_(policy),
+      tokenIntervalNs_(policy.max_logged_per_sec > 0 ? static_cast<int64_t>(1e9 / policy.max_logged_per_sec) : 0) {
 }
 
 grpc::experimental::Interceptor* LoggingInterceptorFactory::CreateServerInterceptor(
     grpc::experimental::ServerRpcInfo* info) {
-    return new LoggingInterceptor(info);
+    if (sampleCall()) {
+        sampled_.fetch_add(1, std::memory_order_relaxed);
+        return new LoggingInterceptor(info);
+    }
+    
+    unsampled_.fetch_add(1, std::memory_order_relaxed);
+    if (policy_.always_log_errors || policy_.slow_threshold_us > 0) {
+        return new LoggingInterceptor(info, LoggingInterceptor::Mode::StatusOnly,
+                                      policy_.always_log_errors, policy_.slow_threshold_us);
+    }
+    
+    // gRPC skips null interceptors, so this call runs with no logging overhead
+    return nullptr;
+}
+
+bool LoggingInterceptorFactory::sampleCall() {
+    if (policy_.sample_one_in == 0) {
+        return false;
+    }
+    if (policy_.sample_one_in > 1 &&
+        callCounter_.fetch_add(1, std::memory_order_relaxed) % policy_.sample_one_in != 0) {
+        return false;
+    }
+    return takeToken();
+}
+
+// Token bucket kept as a single "theoretical arrival time" (GCRA): a call may
+// proceed while that time is less than `burst` intervals ahead of now
+bool LoggingInterceptorFactory::takeToken() {
+    if (tokenIntervalNs_ == 0) {
+        return true;
+    }
+    
+    int64_t now = steadyNowNs();
+    int64_t tolerance = tokenIntervalNs_ * static_cast<int64_t>(policy_.burst > 0 ? policy_.burst - 1 : 0);
+    int64_t tat = bucketTheoreticalNs_.load(std::memory_order_relaxed);
+    
+    while (true) {
+        int64_t base = tat > now ? tat : now;
+        if (base - now > tolerance) {
+            return false;
+        }
+        if (bucketTheoreticalNs_.compare_exchange_weak(tat, base + tokenIntervalNs_, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
 }
 
 } // namespace hello 
\ No newline at end of file
@@ -1,29 +1,67 @@
 #pragma once
 
 #include <grpcpp/grpcpp.h>
-#include <iostream>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace hello {
 
+// Which RPCs get a log line. The defaults log every call, as before.
+struct LoggingPolicy {
+    uint32_t sample_one_in = 1;        // log 1 in N calls fully (0 disables sampling)
+    double max_logged_per_sec = 0;     // token-bucket cap on fully logged calls (0 = unlimited)
+    uint32_t burst = 100;              // bucket depth for max_logged_per_sec
+    bool always_log_errors = true;     // unsampled calls still log a non-OK status
+    uint64_t slow_threshold_us = 0;    // unsampled calls still log if slower (0 = off)
+};
+
 class LoggingInterceptor : public grpc::experimental::Interceptor {
 public:
-    LoggingInterceptor(grpc::experimental::ServerRpcInfo* info);
+    // Full mode logs request and response; status-only mode logs just the
+    // response and only when it is an error or slower than the threshold
+    enum class Mode { Full, StatusOnly };
+    
+    LoggingInterceptor(grpc::experimental::ServerRpcInfo* info, Mode mode = Mode::Full,
+                       bool logErrors = true, uint64_t slowThresholdUs = 0);
     
     void Intercept(grpc::experimental::InterceptorBatchMethods* methods) override;
 
 private:
     grpc::experimental::ServerRpcInfo* info_;
     std::chrono::steady_clock::time_point startTime_;
+    Mode mode_;
+    bool logErrors_;
+    uint64_t slowThresholdUs_;
     
-    void logRequest(const std::string& methodName);
-    void logResponse(const std::string& methodName, grpc::Status status);
+    void logRequest(const char* methodName);
+    void logResponse(const char* methodName, const grpc::Status& status, uint64_t durationUs);
 };
 
+// Decides per RPC, when the call is created, whether it is logged at all.
+// Calls that are neither sampled nor watched for errors/slowness get no
+// interceptor, so they pay no allocation and no hook-point work.
 class LoggingInterceptorFactory : public grpc::experimental::ServerInterceptorFactoryInterface {
 public:
+    explicit LoggingInterceptorFactory(const LoggingPolicy& policy = LoggingPolicy());
+    
     grpc::experimental::Interceptor* CreateServerInterceptor(grpc::experimental::ServerRpcInfo* info) override;
+    
+    uint64_t sampledCalls() const { return sampled_.load(std::memory_order_relaxed); }
+    uint64_t unsampledCalls() const { return unsampled_.load(std::memory_order_relaxed); }
+
+private:
+    bool sampleCall();
+    bool takeToken();
+    
+    LoggingPolicy policy_;
+    int64_t tokenIntervalNs_;
+    
+    alignas(64) std::atomic<uint64_t> callCounter_{0};
+    alignas(64) std::atomic<int64_t> bucketTheoreticalNs_{0};
+    alignas(64) std::atomic<uint64_t> sampled_{0};
+    std::atomic<uint64_t> unsampled_{0};
 };
 
 } // namespace hello 
\ No newline at end of file
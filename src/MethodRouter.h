@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hello {
+
+// Maps gRPC method paths ("/package.Service/Method") to routes through a
+// perfect hash built once at startup. build() searches for a seed under which
+// every registered path lands in its own slot of a power-of-two table, so a
+// lookup is one hash of the path, one slot and one compare, whatever the
+// number of methods, and never allocates. Paths that are not registered hash
+// to some slot too; the compare rejects them.
+//
+// add() and build() are for startup only; once built, find() may be called
+// from any number of threads.
+template<typename Route>
+class MethodRouter {
+public:
+    // false if path is already routed
+    bool add(std::string_view path, const Route& route) {
+        for (const auto& entry : entries_) {
+            if (entry.first == path) {
+                return false;
+            }
+        }
+        entries_.emplace_back(std::string(path), route);
+        built_ = false;
+        return true;
+    }
+
+    // Route already added for path, to adjust before build(); nullptr if none
+    Route* get(std::string_view path) {
+        for (auto& entry : entries_) {
+            if (entry.first == path) {
+                return &entry.second;
+            }
+        }
+        return nullptr;
+    }
+
+    // Lays out the table: two slots per method to start with, doubled until
+    // some seed separates every path
+    void build() {
+        size_t capacity = 4;
+        while (capacity < entries_.size() * 2) {
+            capacity *= 2;
+        }
+        for (;; capacity *= 2) {
+            for (uint64_t seed = 1; seed <= MAX_SEEDS; ++seed) {
+                if (tryLayout(capacity, seed)) {
+                    built_ = true;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Route for path, or nullptr when no method has that path
+    const Route* find(std::string_view path) const {
+        if (!built_) {
+            return nullptr;
+        }
+        const Slot& slot = slots_[hash(path, seed_) & mask_];
+        if (slot.path.size() != path.size() || slot.entry < 0 ||
+            memcmp(slot.path.data(), path.data(), path.size()) != 0) {
+            return nullptr;
+        }
+        return &slot.route;
+    }
+
+    size_t size() const { return entries_.size(); }
+    size_t capacity() const { return slots_.size(); }
+    bool built() const { return built_; }
+
+    const std::vector<std::pair<std::string, Route>>& entries() const { return entries_; }
+
+private:
+    static constexpr uint64_t MAX_SEEDS = 4096;
+
+    struct Slot {
+        std::string path;
+        Route route{};
+        int entry = -1; // index into entries_, -1 = empty
+    };
+
+    // Word-at-a-time multiply/xorshift over the path: four rounds for a
+    // typical 30-byte method path
+    static uint64_t hash(std::string_view path, uint64_t seed) {
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        uint64_t h = seed * MULTIPLIER ^ path.size();
+        size_t pos = 0;
+        for (; pos + 8 <= path.size(); pos += 8) {
+            uint64_t word;
+            memcpy(&word, path.data() + pos, 8);
+            h = (h ^ word) * MULTIPLIER;
+            h ^= h >> 29;
+        }
+        if (pos < path.size()) {
+            uint64_t word = 0;
+            memcpy(&word, path.data() + pos, path.size() - pos);
+            h = (h ^ word) * MULTIPLIER;
+            h ^= h >> 29;
+        }
+        h *= MULTIPLIER;
+        return h ^ (h >> 32);
+    }
+
+    bool tryLayout(size_t capacity, uint64_t seed) {
+        std::vector<Slot> slots(capacity);
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            Slot& slot = slots[hash(entries_[i].first, seed) & (capacity - 1)];
+            if (slot.entry >= 0) {
+                return false;
+            }
+            slot.path = entries_[i].first;
+            slot.route = entries_[i].second;
+            slot.entry = static_cast<int>(i);
+        }
+        slots_ = std::move(slots);
+        seed_ = seed;
+        mask_ = capacity - 1;
+        return true;
+    }
+
+    std::vector<std::pair<std::string, Route>> entries_;
+    std::vector<Slot> slots_;
+    uint64_t seed_ = 0;
+    size_t mask_ = 0;
+    bool built_ = false;
+};
+
+} // namespace hello
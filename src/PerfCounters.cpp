@@ -0,0 +1,210 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hello {
+
+namespace {
+
+int openCounter(uint32_t type, uint64_t config, int group_fd) {
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = type;
+    pe.size = sizeof(pe);
+    pe.config = config;
+    pe.disabled = group_fd < 0 ? 1 : 0;
+    // Context switches are kernel events and would never count with exclude_kernel
+    pe.exclude_kernel = type == PERF_TYPE_HARDWARE ? 1 : 0;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+
+    // pid 0 / cpu -1: follow the calling thread on any CPU
+    return static_cast<int>(syscall(__NR_perf_event_open, &pe, 0, -1, group_fd, 0));
+}
+
+inline void compilerBarrier() {
+    asm volatile("" ::: "memory");
+}
+
+} // namespace
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::open() {
+    close();
+
+    static const uint64_t configs[NUM_HW_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    // The software counter works even where the hypervisor exposes no PMU
+    ctx_switch_fd_ = openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, -1);
+    if (ctx_switch_fd_ >= 0) {
+        ioctl(ctx_switch_fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(ctx_switch_fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    // Cycles lead the group so all hardware counters are scheduled together
+    for (int i = 0; i < NUM_HW_COUNTERS; ++i) {
+        hw_fds_[i] = openCounter(PERF_TYPE_HARDWARE, configs[i], i == 0 ? -1 : hw_fds_[CYCLES]);
+        if (hw_fds_[i] < 0) {
+            int saved_errno = errno;
+            closeHardware();
+            errno = saved_errno;
+            break;
+        }
+    }
+
+    if (hasHardware()) {
+        // Map the control pages so counters can be read in user space with rdpmc
+        rdpmc_ = true;
+        long page_size = sysconf(_SC_PAGESIZE);
+        for (int i = 0; i < NUM_HW_COUNTERS; ++i) {
+            void* addr = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, hw_fds_[i], 0);
+            if (addr == MAP_FAILED) {
+                rdpmc_ = false;
+                continue;
+            }
+            pages_[i] = static_cast<perf_event_mmap_page*>(addr);
+            if (!pages_[i]->cap_user_rdpmc) {
+                rdpmc_ = false;
+            }
+        }
+#if !defined(__x86_64__) && !defined(__i386__)
+        rdpmc_ = false;
+#endif
+
+        ioctl(hw_fds_[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(hw_fds_[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    current_ = PerfSample();
+    calls_ = 0;
+    return isOpen();
+}
+
+void PerfCounters::close() {
+    closeHardware();
+    if (ctx_switch_fd_ >= 0) {
+        ::close(ctx_switch_fd_);
+        ctx_switch_fd_ = -1;
+    }
+}
+
+void PerfCounters::closeHardware() {
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (int i = 0; i < NUM_HW_COUNTERS; ++i) {
+        if (pages_[i]) {
+            munmap(pages_[i], page_size);
+            pages_[i] = nullptr;
+        }
+    }
+    // Members close before the group leader
+    for (int i = NUM_HW_COUNTERS - 1; i >= 0; --i) {
+        if (hw_fds_[i] >= 0) {
+            ::close(hw_fds_[i]);
+            hw_fds_[i] = -1;
+        }
+    }
+    rdpmc_ = false;
+}
+
+const PerfSample& PerfCounters::sample() {
+    if (!isOpen()) {
+        return current_;
+    }
+
+    bool periodic = (++calls_ % READ_INTERVAL) == 0;
+
+    // rdpmc fails while the group is multiplexed out; a syscall read is always valid
+    if (rdpmc_) {
+        if (!readHardwareRdpmc()) {
+            readHardwareSyscall();
+        }
+    } else if (periodic && hasHardware()) {
+        readHardwareSyscall();
+    }
+
+    if (periodic) {
+        readContextSwitches();
+    }
+
+    return current_;
+}
+
+bool PerfCounters::readHardwareRdpmc() {
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t values[NUM_HW_COUNTERS];
+
+    for (int i = 0; i < NUM_HW_COUNTERS; ++i) {
+        perf_event_mmap_page* pc = pages_[i];
+        uint32_t seq;
+        uint64_t count;
+
+        // The kernel updates the page under a sequence lock
+        do {
+            seq = pc->lock;
+            compilerBarrier();
+
+            uint32_t index = pc->index;
+            if (!pc->cap_user_rdpmc || index == 0) {
+                return false;
+            }
+
+            count = pc->offset;
+            uint16_t width = pc->pmc_width;
+            int64_t pmc = static_cast<int64_t>(__builtin_ia32_rdpmc(index - 1));
+            pmc <<= 64 - width;
+            pmc >>= 64 - width;
+            count += pmc;
+
+            compilerBarrier();
+        } while (pc->lock != seq);
+
+        values[i] = count;
+    }
+
+    current_.cycles = values[CYCLES];
+    current_.instructions = values[INSTRUCTIONS];
+    current_.cache_misses = values[CACHE_MISSES];
+    current_.branch_misses = values[BRANCH_MISSES];
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfCounters::readHardwareSyscall() {
+    // PERF_FORMAT_GROUP layout: nr, then one value per group member in open order
+    uint64_t buffer[1 + NUM_HW_COUNTERS];
+    if (read(hw_fds_[CYCLES], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+        return;
+    }
+
+    current_.cycles = buffer[1 + CYCLES];
+    current_.instructions = buffer[1 + INSTRUCTIONS];
+    current_.cache_misses = buffer[1 + CACHE_MISSES];
+    current_.branch_misses = buffer[1 + BRANCH_MISSES];
+}
+
+void PerfCounters::readContextSwitches() {
+    if (ctx_switch_fd_ < 0) {
+        return;
+    }
+
+    uint64_t buffer[2];
+    if (read(ctx_switch_fd_, buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer))) {
+        current_.context_switches = buffer[1];
+    }
+}
+
+} // namespace hello
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <linux/perf_event.h>
+
+namespace hello {
+
+// Cumulative hardware/software counter values for one thread
+struct PerfSample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+    uint64_t context_switches = 0;
+};
+
+// Per-thread perf_event counters (user-space only, so time blocked in epoll_wait
+// is not counted). Hardware counters are read with rdpmc through the mmap'd
+// control page when the kernel allows it; otherwise, and for the software
+// context-switch counter, sample() falls back to a read() every READ_INTERVAL calls.
+class PerfCounters {
+public:
+    PerfCounters() = default;
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Opens the counters for the calling thread; true if at least the software
+    // counter is available. On hardware failure errno is left from perf_event_open.
+    bool open();
+    void close();
+
+    bool isOpen() const { return hasHardware() || ctx_switch_fd_ >= 0; }
+    bool hasHardware() const { return hw_fds_[CYCLES] >= 0; }
+    bool usingRdpmc() const { return rdpmc_; }
+
+    // Updates and returns the cumulative values; cheap enough to call per epoll batch
+    const PerfSample& sample();
+
+private:
+    enum HwCounter { CYCLES = 0, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_HW_COUNTERS };
+
+    static constexpr uint32_t READ_INTERVAL = 64;
+
+    void closeHardware();
+    bool readHardwareRdpmc();
+    void readHardwareSyscall();
+    void readContextSwitches();
+
+    int hw_fds_[NUM_HW_COUNTERS] = {-1, -1, -1, -1};
+    perf_event_mmap_page* pages_[NUM_HW_COUNTERS] = {nullptr, nullptr, nullptr, nullptr};
+    int ctx_switch_fd_ = -1;
+    bool rdpmc_ = false;
+    uint32_t calls_ = 0;
+    PerfSample current_;
+};
+
+} // namespace hello
@@ -0,0 +1,129 @@
+#include "ResponseCache.h"
+#include <functional>
+
+namespace hello {
+
+ResponseCache::ResponseCache(size_t capacity) : entries_(capacity > 0 ? capacity : 1) {
+    // Keep the index at most half full so probe sequences stay short
+    size_t index_size = 1;
+    while (index_size < entries_.size() * 2) {
+        index_size <<= 1;
+    }
+    index_.assign(index_size, 0);
+    index_mask_ = index_size - 1;
+}
+
+uint64_t ResponseCache::hashKey(std::string_view name, int32_t age) {
+    uint64_t hash = std::hash<std::string_view>{}(name);
+    hash ^= (static_cast<uint64_t>(static_cast<uint32_t>(age)) + 0x9E3779B97F4A7C15ULL) + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+size_t ResponseCache::findIndexSlot(uint64_t hash, std::string_view name, int32_t age) const {
+    size_t slot = hash & index_mask_;
+    while (index_[slot] != 0) {
+        const Entry& entry = entries_[index_[slot] - 1];
+        if (entry.hash == hash && entry.age == age && entry.name == name) {
+            return slot;
+        }
+        slot = (slot + 1) & index_mask_;
+    }
+    return slot;
+}
+
+void ResponseCache::eraseIndexSlot(size_t slot) {
+    // Backward-shift deletion: pull later entries of the same probe run into the
+    // hole so lookups never need tombstones
+    size_t hole = slot;
+    size_t next = (hole + 1) & index_mask_;
+    while (index_[next] != 0) {
+        size_t home = entries_[index_[next] - 1].hash & index_mask_;
+        if (((next - home) & index_mask_) >= ((next - hole) & index_mask_)) {
+            index_[hole] = index_[next];
+            hole = next;
+        }
+        next = (next + 1) & index_mask_;
+    }
+    index_[hole] = 0;
+}
+
+uint32_t ResponseCache::evictOne() {
+    while (true) {
+        Entry& entry = entries_[clock_hand_];
+        size_t victim = clock_hand_;
+        clock_hand_ = (clock_hand_ + 1) % entries_.size();
+
+        if (entry.referenced) {
+            entry.referenced = false; // second chance
+            continue;
+        }
+
+        eraseIndexSlot(findIndexSlot(entry.hash, entry.name, entry.age));
+        ++evictions_;
+        return static_cast<uint32_t>(victim);
+    }
+}
+
+std::vector<uint8_t>* ResponseCache::find(std::string_view name, int32_t age) {
+    size_t slot = findIndexSlot(hashKey(name, age), name, age);
+    if (index_[slot] == 0) {
+        ++misses_;
+        return nullptr;
+    }
+
+    Entry& entry = entries_[index_[slot] - 1];
+    entry.referenced = true;
+    ++hits_;
+    return &entry.frame;
+}
+
+std::vector<uint8_t>* ResponseCache::insert(std::string_view name, int32_t age, std::vector<uint8_t>&& frame) {
+    Entry* entry = claimEntry(name, age);
+    if (!entry) {
+        return nullptr;
+    }
+    entry->frame = std::move(frame);
+    return &entry->frame;
+}
+
+std::vector<uint8_t>* ResponseCache::insert(std::string_view name, int32_t age, const uint8_t* frame, size_t size) {
+    Entry* entry = claimEntry(name, age);
+    if (!entry) {
+        return nullptr;
+    }
+    // Reuses the frame capacity of the replaced or evicted entry
+    entry->frame.assign(frame, frame + size);
+    return &entry->frame;
+}
+
+ResponseCache::Entry* ResponseCache::claimEntry(std::string_view name, int32_t age) {
+    if (name.size() > MAX_NAME_LENGTH) {
+        return nullptr;
+    }
+
+    uint64_t hash = hashKey(name, age);
+    size_t slot = findIndexSlot(hash, name, age);
+    if (index_[slot] != 0) {
+        return &entries_[index_[slot] - 1];
+    }
+
+    uint32_t entry_index;
+    if (size_ < entries_.size()) {
+        entry_index = static_cast<uint32_t>(size_++);
+    } else {
+        entry_index = evictOne();
+        slot = findIndexSlot(hash, name, age); // eviction may have shifted the run
+    }
+
+    // Reassigning the name reuses the evicted entry's string capacity
+    Entry& entry = entries_[entry_index];
+    entry.hash = hash;
+    entry.name.assign(name.data(), name.size());
+    entry.age = age;
+    entry.referenced = false;
+
+    index_[slot] = entry_index + 1;
+    return &entry;
+}
+
+} // namespace hello
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hello {
+
+// Bounded map from the (name, age) of a HelloRequest to its fully encoded
+// response frame. One instance is owned by each epoll worker, so lookups take no
+// locks; the workers together act as a sharded cache. Eviction is CLOCK: a hit
+// sets the entry's reference bit and the hand clears bits until it finds a
+// victim. Lookups hash a string_view and never allocate; only inserts do.
+class ResponseCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    static constexpr size_t MAX_NAME_LENGTH = 256; // longer names are not cached
+
+    explicit ResponseCache(size_t capacity = DEFAULT_CAPACITY);
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    // Returns the cached frame, valid until the next insert() on this cache. The
+    // owning worker may patch fixed-width slots (e.g. the timestamp) in place.
+    std::vector<uint8_t>* find(std::string_view name, int32_t age);
+
+    // Stores frame (taking it only on success) and returns the cached copy,
+    // or nullptr when the key is not cacheable
+    std::vector<uint8_t>* insert(std::string_view name, int32_t age, std::vector<uint8_t>&& frame);
+
+    // Same, copying the frame; an evicted entry's buffer is reused, so once the
+    // cache is warm inserts stop allocating
+    std::vector<uint8_t>* insert(std::string_view name, int32_t age, const uint8_t* frame, size_t size);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return entries_.size(); }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        std::string name;
+        int32_t age = 0;
+        bool referenced = false;
+        std::vector<uint8_t> frame;
+    };
+
+    static uint64_t hashKey(std::string_view name, int32_t age);
+
+    // Entry for the key, existing or newly indexed (evicting if full), with its
+    // frame left for the caller to fill; nullptr when the key is not cacheable
+    Entry* claimEntry(std::string_view name, int32_t age);
+
+    // Open-addressing index of entry numbers (+1, 0 = empty) with linear probing
+    size_t findIndexSlot(uint64_t hash, std::string_view name, int32_t age) const;
+    void eraseIndexSlot(size_t slot);
+    uint32_t evictOne();
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> index_;
+    size_t index_mask_;
+    size_t clock_hand_ = 0;
+    size_t size_ = 0;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace hello
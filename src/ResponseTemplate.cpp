@@ -0,0 +1,136 @@
+#include "ResponseTemplate.h"
+#include "GreetingFormatter.h"
+#include <cstring>
+
+namespace hello {
+
+namespace {
+
+constexpr uint8_t MESSAGE_TAG = (1 << 3) | 2;   // HelloResponse.message, length-delimited
+constexpr uint8_t TIMESTAMP_TAG = (2 << 3) | 0; // HelloResponse.timestamp, varint
+
+constexpr uint8_t FRAME_TYPE_DATA = 0x00;
+constexpr uint8_t FLAG_END_STREAM = 0x01;
+
+size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+uint8_t* writeVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+uint8_t* writeLiteral(uint8_t* out, std::string_view literal) {
+    memcpy(out, literal.data(), literal.size());
+    return out + literal.size();
+}
+
+size_t ageDigits(int32_t age, char* buffer) {
+    return GreetingFormatter::formatInt(buffer, age) - buffer;
+}
+
+size_t messageSize(std::string_view name, size_t age_digits) {
+    return GreetingFormatter::LITERAL_SIZE + name.size() + age_digits;
+}
+
+size_t protobufSize(size_t message_size) {
+    return 1 + varintSize(message_size) + message_size + 1 + HelloResponseTemplate::TIMESTAMP_SLOT;
+}
+
+// HTTP/2 DATA frame header on stream 1, then the gRPC length prefix
+uint8_t* writeFramePrefix(uint8_t* p, size_t protobuf_size, uint8_t flags) {
+    size_t payload_size = HelloResponseTemplate::GRPC_PREFIX_SIZE + protobuf_size;
+    *p++ = static_cast<uint8_t>(payload_size >> 16);
+    *p++ = static_cast<uint8_t>(payload_size >> 8);
+    *p++ = static_cast<uint8_t>(payload_size);
+    *p++ = FRAME_TYPE_DATA;
+    *p++ = flags;
+    *p++ = 0;
+    *p++ = 0;
+    *p++ = 0;
+    *p++ = 1;
+
+    // gRPC length prefix, uncompressed
+    *p++ = 0;
+    *p++ = static_cast<uint8_t>(protobuf_size >> 24);
+    *p++ = static_cast<uint8_t>(protobuf_size >> 16);
+    *p++ = static_cast<uint8_t>(protobuf_size >> 8);
+    *p++ = static_cast<uint8_t>(protobuf_size);
+    return p;
+}
+
+} // namespace
+
+size_t HelloResponseTemplate::encodedSize(std::string_view name, int32_t age) {
+    char digits[GreetingFormatter::MAX_INT_DIGITS];
+    return FRAME_HEADER_SIZE + GRPC_PREFIX_SIZE + protobufSize(messageSize(name, ageDigits(age, digits)));
+}
+
+size_t HelloResponseTemplate::encode(uint8_t* out, std::string_view name, int32_t age, uint64_t timestamp_us) {
+    char digits[GreetingFormatter::MAX_INT_DIGITS];
+    size_t digit_count = ageDigits(age, digits);
+    size_t message_size = messageSize(name, digit_count);
+    size_t protobuf_size = protobufSize(message_size);
+
+    uint8_t* p = writeFramePrefix(out, protobuf_size, FLAG_END_STREAM);
+
+    // HelloResponse.message
+    *p++ = MESSAGE_TAG;
+    p = writeVarint(p, message_size);
+    p = writeLiteral(p, GreetingFormatter::PREFIX);
+    p = writeLiteral(p, name);
+    p = writeLiteral(p, GreetingFormatter::MIDDLE);
+    p = writeLiteral(p, std::string_view(digits, digit_count));
+    p = writeLiteral(p, GreetingFormatter::SUFFIX);
+
+    // HelloResponse.timestamp
+    *p++ = TIMESTAMP_TAG;
+    p += TIMESTAMP_SLOT;
+
+    size_t size = p - out;
+    patchTimestamp(out, size, timestamp_us);
+    return size;
+}
+
+size_t HelloResponseTemplate::encodedMessageSize(std::string_view message) {
+    return FRAME_HEADER_SIZE + GRPC_PREFIX_SIZE + protobufSize(message.size());
+}
+
+size_t HelloResponseTemplate::encodeMessage(uint8_t* out, std::string_view message, uint64_t timestamp_us,
+                                            bool end_stream) {
+    uint8_t* p = writeFramePrefix(out, protobufSize(message.size()), end_stream ? FLAG_END_STREAM : 0);
+
+    *p++ = MESSAGE_TAG;
+    p = writeVarint(p, message.size());
+    p = writeLiteral(p, message);
+
+    *p++ = TIMESTAMP_TAG;
+    p += TIMESTAMP_SLOT;
+
+    size_t size = p - out;
+    patchTimestamp(out, size, timestamp_us);
+    return size;
+}
+
+void HelloResponseTemplate::patchTimestamp(uint8_t* frame, size_t frame_size, uint64_t timestamp_us) {
+    // Padded varint: continuation bit on every byte but the last, so the slot
+    // width never depends on the value
+    uint8_t* slot = frame + frame_size - TIMESTAMP_SLOT;
+    for (size_t i = 0; i < TIMESTAMP_SLOT - 1; ++i) {
+        slot[i] = static_cast<uint8_t>(timestamp_us & 0x7F) | 0x80;
+        timestamp_us >>= 7;
+    }
+    slot[TIMESTAMP_SLOT - 1] = static_cast<uint8_t>(timestamp_us & 0x01);
+}
+
+} // namespace hello
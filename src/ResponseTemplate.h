@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace hello {
+
+// Precompiled wire-format template for SayHello responses on the epoll path.
+// The frame is laid out as
+//
+//   HTTP/2 DATA header (9) | gRPC prefix (5) | 0x0A len "Hello, " name
+//   "! You are " age " years old. Welcome to gRPC!" | 0x10 timestamp (10)
+//
+// i.e. a HelloResponse{message, timestamp} carrying the same text as
+// HelloServiceImpl::SayHello. Encoding is a handful of memcpys of the literal
+// parts plus patching the three lengths; no protobuf object or std::string is
+// built. The timestamp is a fixed-width (padded) varint in the last
+// TIMESTAMP_SLOT bytes, so an already encoded frame, e.g. one held by
+// ResponseCache, can be re-stamped in place with patchTimestamp().
+class HelloResponseTemplate {
+public:
+    static constexpr size_t FRAME_HEADER_SIZE = 9;
+    static constexpr size_t GRPC_PREFIX_SIZE = 5;
+    static constexpr size_t TIMESTAMP_SLOT = 10;
+
+    // Exact encoded size of the frame for a given request
+    static size_t encodedSize(std::string_view name, int32_t age);
+
+    // Writes the whole frame to out, which must hold encodedSize() bytes;
+    // returns the number of bytes written
+    static size_t encode(uint8_t* out, std::string_view name, int32_t age, uint64_t timestamp_us);
+
+    // Frame for an arbitrary HelloResponse.message, e.g. one message of a
+    // stream; end_stream = false leaves the stream open for more
+    static size_t encodedMessageSize(std::string_view message);
+    static size_t encodeMessage(uint8_t* out, std::string_view message, uint64_t timestamp_us, bool end_stream);
+
+    // Rewrites the timestamp slot at the end of a frame produced by encode()
+    static void patchTimestamp(uint8_t* frame, size_t frame_size, uint64_t timestamp_us);
+};
+
+} // namespace hello
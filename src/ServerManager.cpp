@@ -1,7 +1,11 @@
 #include "ServerManager.h"
 #include "HelloService.h"
+#include "AsyncServer.h"
 #include "LoggingInterceptor.h"
+#include "AsyncLogger.h"
+#include "CoarseClock.h"
 #include <iostream>
+#include <algorithm>
 #include <grpcpp/grpcpp.h>
 
 namespace hello {
@@ -12,6 +16,10 @@ ServerManager& ServerManager::getInstance() {
 }
 
 bool ServerManager::startServer(const std::string& serverAddress) {
+    return startServer(serverAddress, Options());
+}
+
+bool ServerManager::startServer(const std::string& serverAddress, const Options& options) {
     if (running_.load()) {
         std::cout << "Server is already running" << std::endl;
         return false;
@@ -20,10 +28,28 @@ bool ServerManager::startServer(const std::string& serverAddress) {
     serverAddress_ = serverAddress;
     
     // Create service
-    service_ = std::make_unique<HelloServiceImpl>();
-    
-    // Create interceptor factory
-    interceptorFactory_ = std::make_unique<LoggingInterceptorFactory>();
+    if (options.mode == ServerMode::Async) {
+        unsigned queues = options.completion_queues;
+        if (queues == 0) {
+            queues = std::max(1u, std::thread::hardware_concurrency());
+        }
+        asyncServer_ = std::make_unique<AsyncHelloServer>(queues, options.stream_pacing);
+        service_.reset();
+    } else if (options.mode == ServerMode::Callback) {
+        auto service = std::make_unique<HelloServiceCallbackImpl>();
+        service->setStreamPacing(options.stream_pacing);
+        service_ = std::move(service);
+    } else {
+        std::unique_ptr<HelloServiceImpl> service;
+        if (options.arena_messages) {
+            service = std::make_unique<HelloServiceArenaImpl>();
+        } else {
+            service = std::make_unique<HelloServiceImpl>();
+        }
+        service->setStreamPacing(options.stream_pacing);
+        syncService_ = service.get();
+        service_ = std::move(service);
+    }
     
     // Build server with optimized settings
     grpc::ServerBuilder builder;
@@ -39,21 +65,39 @@ bool ServerManager::startServer(const std::string& serverAddress) {
     builder.SetMaxSendMessageSize(INT_MAX);
     
     builder.AddListeningPort(serverAddress, grpc::InsecureServerCredentials());
-    builder.RegisterService(service_.get());
+    if (!options.unix_socket_path.empty()) {
+        builder.AddListeningPort("unix:" + options.unix_socket_path, grpc::InsecureServerCredentials());
+    }
+    if (asyncServer_) {
+        asyncServer_->configure(builder);
+    } else {
+        builder.RegisterService(service_.get());
+    }
     
     std::vector<std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>> interceptors;
-    interceptors.push_back(std::make_unique<LoggingInterceptorFactory>());
+    interceptors.push_back(std::make_unique<LoggingInterceptorFactory>(loggingPolicy_));
     builder.experimental().SetInterceptorCreators(std::move(interceptors));
     
     server_ = builder.BuildAndStart();
     if (!server_) {
         std::cerr << "Failed to start server on " << serverAddress << std::endl;
+        asyncServer_.reset();
         return false;
     }
     
     running_.store(true);
+    CoarseClock::getInstance().start();
     std::cout << "gRPC Server started on " << serverAddress << std::endl;
-    std::cout << "Optimized for high performance with enhanced thread pool" << std::endl;
+    if (!options.unix_socket_path.empty()) {
+        std::cout << "Also listening on unix:" << options.unix_socket_path << std::endl;
+    }
+    if (asyncServer_) {
+        asyncServer_->start();
+        std::cout << "Async mode: " << asyncServer_->numQueues()
+                  << " completion queue(s), one pinned thread each" << std::endl;
+    } else {
+        std::cout << "Optimized for high performance with enhanced thread pool" << std::endl;
+    }
     
     // Start server in a separate thread
     serverThread_ = std::thread([this]() {
@@ -70,13 +114,29 @@ void ServerManager::stopServer() {
     }
     
     std::cout << "Stopping gRPC server..." << std::endl;
+    // Synchronous streams hold their handler threads; end them so Shutdown()
+    // does not wait out their remaining messages
+    if (syncService_) {
+        syncService_->stopStreams();
+    }
     server_->Shutdown();
     
     if (serverThread_.joinable()) {
         serverThread_.join();
     }
     
+    // Queues may only be shut down once the server has shut down
+    if (asyncServer_) {
+        asyncServer_->stop();
+    }
+    
+    // Destroy the server before a restart replaces the service it references
+    server_.reset();
+    asyncServer_.reset();
+    syncService_ = nullptr;
     running_.store(false);
+    CoarseClock::getInstance().stop();
+    AsyncLogger::getInstance().flush();
     std::cout << "gRPC Server stopped" << std::endl;
 }
 
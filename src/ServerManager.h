@@ -5,15 +5,22 @@
 #include <string>
 #include <thread>
 #include <atomic>
+#include "LoggingInterceptor.h"
+#include "HelloService.h"
 
 // Forward declarations
 namespace hello {
-    class HelloServiceImpl;
-    class LoggingInterceptorFactory;
+    class AsyncHelloServer;
 }
 
 namespace hello {
 
+enum class ServerMode {
+    Sync,    // grpc++ synchronous server: poller threads hand each RPC to a handler thread
+    Async,   // one completion queue per core, drained by a pinned thread (AsyncHelloServer)
+    Callback // callback API reactors, run inline on gRPC's event-engine threads
+};
+
 class ServerManager {
 public:
     static ServerManager& getInstance();
@@ -22,17 +29,40 @@ public:
     ServerManager(const ServerManager&) = delete;
     ServerManager& operator=(const ServerManager&) = delete;
     
+    struct Options {
+        // Sync mode: serve SayHello on the callback API with pooled per-RPC
+        // protobuf arenas instead of the synchronous handler with
+        // heap-allocated messages. Callback mode always uses the arenas
+        bool arena_messages = false;
+        
+        ServerMode mode = ServerMode::Sync;
+        // Async mode: number of completion queues/threads, 0 = one per core
+        unsigned completion_queues = 0;
+        
+        // Default SayHelloStream shape; requests may override within its limits
+        StreamPacing stream_pacing;
+        
+        // Also listen on unix:<path> next to the TCP address; empty = TCP only
+        std::string unix_socket_path;
+    };
+    
     bool startServer(const std::string& serverAddress);
+    bool startServer(const std::string& serverAddress, const Options& options);
     void stopServer();
     bool isRunning() const;
     
+    // Applies to servers started after the call
+    void setLoggingPolicy(const LoggingPolicy& policy) { loggingPolicy_ = policy; }
+    
 private:
     ServerManager() = default;
     ~ServerManager() = default;
     
     std::unique_ptr<grpc::Server> server_;
-    std::unique_ptr<HelloServiceImpl> service_;
-    std::unique_ptr<LoggingInterceptorFactory> interceptorFactory_;
+    std::unique_ptr<grpc::Service> service_;
+    HelloServiceImpl* syncService_ = nullptr; // service_ in sync mode
+    std::unique_ptr<AsyncHelloServer> asyncServer_;
+    LoggingPolicy loggingPolicy_;
     std::string serverAddress_;
     std::atomic<bool> running_{false};
     std::thread serverThread_;
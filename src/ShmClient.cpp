@@ -0,0 +1,106 @@
+#include "ShmClient.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hello {
+
+ShmHelloClient::~ShmHelloClient() {
+    close();
+}
+
+bool ShmHelloClient::connect(const std::string& socket_path, ShmWaitMode mode) {
+    close();
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Shm socket path too long: " << socket_path << std::endl;
+        return false;
+    }
+    memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    control_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (control_fd_ < 0 || ::connect(control_fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::cerr << "Failed to connect to shm server at " << socket_path << ": " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    uint8_t request = static_cast<uint8_t>(mode);
+    uint8_t status = 0xFF;
+    int fd = -1;
+    if (::send(control_fd_, &request, 1, MSG_NOSIGNAL) == 1) {
+        fd = receiveChannelFd(control_fd_, status);
+    }
+    if (fd < 0 || status != 0) {
+        std::cerr << "Shm server at " << socket_path << " refused the channel" << std::endl;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        close();
+        return false;
+    }
+
+    if (!channel_.attach(fd)) {
+        close();
+        return false;
+    }
+
+    // The control socket stays open: the server detaches the channel when it closes
+    requests_ = channel_.requests();
+    responses_ = channel_.responses();
+    mode_ = mode;
+    next_id_ = 0;
+    return true;
+}
+
+void ShmHelloClient::close() {
+    // The server's session thread ends when it sees the control socket close
+    channel_.close();
+    if (control_fd_ >= 0) {
+        ::close(control_fd_);
+        control_fd_ = -1;
+    }
+}
+
+bool ShmHelloClient::sayHello(const HelloRequest& request, HelloResponse* response,
+                              std::chrono::microseconds timeout) {
+    return send(request) && receive(response, timeout);
+}
+
+bool ShmHelloClient::send(const HelloRequest& request) {
+    if (!channel_.isOpen()) {
+        return false;
+    }
+
+    size_t size = request.ByteSizeLong();
+    ShmRingLayout::Slot* slot = requests_.tryReserve();
+    if (!slot || size > ShmRingLayout::MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    request.SerializeWithCachedSizesToArray(slot->data);
+    slot->size = static_cast<uint32_t>(size);
+    slot->status = ShmRingLayout::STATUS_OK;
+    slot->id = next_id_++;
+    requests_.commit();
+    return true;
+}
+
+bool ShmHelloClient::receive(HelloResponse* response, std::chrono::microseconds timeout) {
+    if (!channel_.isOpen() || !responses_.waitForData(mode_, timeout.count())) {
+        return false;
+    }
+
+    const ShmRingLayout::Slot* slot = responses_.peek();
+    bool ok = slot->status == ShmRingLayout::STATUS_OK && response->ParseFromArray(slot->data, slot->size);
+    responses_.consume();
+    return ok;
+}
+
+} // namespace hello
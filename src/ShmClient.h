@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ShmRing.h"
+#include "HelloService.pb.h"
+#include <chrono>
+#include <string>
+
+namespace hello {
+
+// Client side of the shared-memory transport. connect() performs the
+// handshake on the server's control socket and maps the channel; after that
+// requests and responses move through the rings without system calls (in
+// BusyPoll mode) or with a futex wake per message (Futex mode). One client
+// object per thread: each ring has exactly one producer and one consumer.
+class ShmHelloClient {
+public:
+    ShmHelloClient() = default;
+    ~ShmHelloClient();
+
+    ShmHelloClient(const ShmHelloClient&) = delete;
+    ShmHelloClient& operator=(const ShmHelloClient&) = delete;
+
+    bool connect(const std::string& socket_path, ShmWaitMode mode = ShmWaitMode::BusyPoll);
+    void close();
+    bool isConnected() const { return channel_.isOpen(); }
+
+    // One round trip. Reusing request/response across calls keeps their
+    // string capacity, so steady-state calls do not allocate.
+    bool sayHello(const HelloRequest& request, HelloResponse* response,
+                  std::chrono::microseconds timeout = std::chrono::seconds(1));
+
+    // Pipelined use: up to SLOT_COUNT requests may be outstanding; responses
+    // come back in request order
+    bool send(const HelloRequest& request);
+    bool receive(HelloResponse* response, std::chrono::microseconds timeout = std::chrono::seconds(1));
+
+private:
+    ShmChannel channel_;
+    ShmRing requests_;
+    ShmRing responses_;
+    ShmWaitMode mode_ = ShmWaitMode::BusyPoll;
+    int control_fd_ = -1;
+    uint64_t next_id_ = 0;
+};
+
+} // namespace hello
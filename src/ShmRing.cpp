@@ -0,0 +1,217 @@
+#include "ShmRing.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+namespace hello {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+uint64_t monotonicMicros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Shared (not FUTEX_PRIVATE) operations: the word lives in a mapping seen by two processes
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, uint64_t timeout_us) {
+    struct timespec timeout;
+    timeout.tv_sec = timeout_us / 1000000;
+    timeout.tv_nsec = (timeout_us % 1000000) * 1000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+void ShmRing::commit() {
+    // Sequentially consistent pair with waitForData: either the consumer sees the
+    // new head before sleeping, or we see its waiting flag and wake it
+    ring_->head.store(ring_->head.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    if (ring_->waiting.load(std::memory_order_seq_cst)) {
+        futexWake(&ring_->head);
+    }
+}
+
+bool ShmRing::waitForData(ShmWaitMode mode, uint64_t timeout_us) {
+    uint64_t deadline = 0;
+    while (true) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (peek()) {
+                return true;
+            }
+            cpuRelax();
+        }
+
+        uint64_t now = monotonicMicros();
+        if (deadline == 0) {
+            deadline = now + timeout_us;
+        } else if (now >= deadline) {
+            return peek() != nullptr;
+        }
+
+        if (mode == ShmWaitMode::BusyPoll) {
+            // Let the peer run if it shares this core
+            sched_yield();
+            continue;
+        }
+
+        uint32_t head = ring_->head.load(std::memory_order_relaxed);
+        ring_->waiting.store(1, std::memory_order_seq_cst);
+        if (ring_->head.load(std::memory_order_seq_cst) != ring_->tail.load(std::memory_order_relaxed)) {
+            ring_->waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        futexWait(&ring_->head, head, deadline - now);
+        ring_->waiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+ShmChannel::~ShmChannel() {
+    close();
+}
+
+bool ShmChannel::create(const std::string& name) {
+    close();
+
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to create shm channel " << name << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(ShmRingLayout)) != 0) {
+        std::cerr << "Failed to size shm channel " << name << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, sizeof(ShmRingLayout), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to map shm channel " << name << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // ftruncate zero-fills: empty rings, nobody waiting
+    layout_ = static_cast<ShmRingLayout*>(addr);
+    fd_ = fd;
+
+    auto& header = layout_->header;
+    header.version = ShmRingLayout::VERSION;
+    header.slot_count = ShmRingLayout::SLOT_COUNT;
+    header.slot_size = ShmRingLayout::SLOT_SIZE;
+    header.server_pid = getpid();
+
+    // Publish the magic last so a client never attaches to a half-initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header.magic = ShmRingLayout::MAGIC;
+    return true;
+}
+
+bool ShmChannel::attach(int fd) {
+    close();
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingLayout)) {
+        std::cerr << "Shm channel is too small" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, sizeof(ShmRingLayout), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to map shm channel: " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    auto* layout = static_cast<ShmRingLayout*>(addr);
+    if (layout->header.magic != ShmRingLayout::MAGIC || layout->header.version != ShmRingLayout::VERSION ||
+        layout->header.slot_count != ShmRingLayout::SLOT_COUNT || layout->header.slot_size != ShmRingLayout::SLOT_SIZE) {
+        std::cerr << "Shm channel layout mismatch (version " << layout->header.version << ")" << std::endl;
+        munmap(addr, sizeof(ShmRingLayout));
+        ::close(fd);
+        return false;
+    }
+
+    layout_ = layout;
+    fd_ = fd;
+    return true;
+}
+
+void ShmChannel::close() {
+    if (layout_) {
+        munmap(layout_, sizeof(ShmRingLayout));
+        layout_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool sendChannelFd(int socket_fd, int channel_fd, uint8_t status) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    struct iovec iov = {&status, 1};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (channel_fd >= 0) {
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &channel_fd, sizeof(int));
+    }
+
+    return sendmsg(socket_fd, &msg, MSG_NOSIGNAL) == 1;
+}
+
+int receiveChannelFd(int socket_fd, uint8_t& status) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    struct iovec iov = {&status, 1};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if (recvmsg(socket_fd, &msg, MSG_CMSG_CLOEXEC) != 1) {
+        return -1;
+    }
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+        return -1;
+    }
+    int fd;
+    memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    return fd;
+}
+
+} // namespace hello
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace hello {
+
+// How the consuming side of a ring waits for the next slot
+enum class ShmWaitMode : uint8_t {
+    BusyPoll = 0, // spin, yielding the CPU between spin rounds; never sleeps in the kernel
+    Futex = 1     // spin briefly, then sleep on the ring's head word until the producer wakes it
+};
+
+// Layout of one client's shared-memory channel: a request ring (client ->
+// server) and a response ring (server -> client), each single-producer /
+// single-consumer. The memfd holding it is created by the server and handed
+// to the client over the control socket, so nothing appears under /dev/shm.
+//
+// Producer and consumer indices live on separate cache lines. `head` doubles
+// as the futex word: a consumer that has set `waiting` sleeps on it, and the
+// producer wakes it after advancing head.
+struct ShmRingLayout {
+    static constexpr uint64_t MAGIC = 0x6752706352696e67ULL; // "gRpcRing"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t SLOT_COUNT = 64; // power of two
+    static constexpr uint32_t SLOT_SIZE = 1024;
+
+    // Slot status: set by the server on responses
+    static constexpr uint32_t STATUS_OK = 0;
+    static constexpr uint32_t STATUS_BAD_REQUEST = 1;
+
+    struct alignas(64) Slot {
+        uint32_t size;   // bytes of serialized message in data
+        uint32_t status;
+        uint64_t id;     // echoed from request to response
+        uint8_t data[SLOT_SIZE - 16];
+    };
+
+    static constexpr size_t MAX_MESSAGE_SIZE = sizeof(Slot::data);
+
+    struct Ring {
+        alignas(64) std::atomic<uint32_t> head;    // written by the producer
+        alignas(64) std::atomic<uint32_t> tail;    // written by the consumer
+        std::atomic<uint32_t> waiting;             // consumer is (about to be) asleep on head
+        alignas(64) Slot slots[SLOT_COUNT];
+    };
+
+    struct alignas(64) Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t slot_count;
+        uint32_t slot_size;
+        int32_t server_pid;
+    };
+
+    Header header;
+    Ring requests;
+    Ring responses;
+};
+
+// One side's view of a ring. All operations are wait-free except waitForData.
+class ShmRing {
+public:
+    ShmRing() = default;
+    explicit ShmRing(ShmRingLayout::Ring* ring) : ring_(ring) {}
+
+    // Producer: slot to fill, or nullptr when the ring is full
+    ShmRingLayout::Slot* tryReserve() {
+        uint32_t head = ring_->head.load(std::memory_order_relaxed);
+        if (head - ring_->tail.load(std::memory_order_acquire) >= ShmRingLayout::SLOT_COUNT) {
+            return nullptr;
+        }
+        return &ring_->slots[head & (ShmRingLayout::SLOT_COUNT - 1)];
+    }
+
+    // Producer: publishes the reserved slot and wakes a sleeping consumer
+    void commit();
+
+    // Consumer: oldest unread slot, or nullptr when the ring is empty
+    const ShmRingLayout::Slot* peek() const {
+        uint32_t tail = ring_->tail.load(std::memory_order_relaxed);
+        if (tail == ring_->head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &ring_->slots[tail & (ShmRingLayout::SLOT_COUNT - 1)];
+    }
+
+    // Consumer: hands the slot returned by peek() back to the producer
+    void consume() {
+        ring_->tail.store(ring_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: returns once the ring has data or timeout_us has passed
+    // (false). Both modes spin SPIN_LIMIT pauses first; BusyPoll then yields
+    // and spins again, Futex sleeps until the producer's commit() wakes it.
+    bool waitForData(ShmWaitMode mode, uint64_t timeout_us);
+
+    static constexpr int SPIN_LIMIT = 256;
+
+private:
+    ShmRingLayout::Ring* ring_ = nullptr;
+};
+
+// Owner of one channel mapping. The server create()s it and sends fd() to
+// the client, which attach()es to its copy of the descriptor.
+class ShmChannel {
+public:
+    ShmChannel() = default;
+    ~ShmChannel();
+
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+
+    bool create(const std::string& name);
+    bool attach(int fd); // takes ownership of fd
+    void close();
+
+    bool isOpen() const { return layout_ != nullptr; }
+    int fd() const { return fd_; }
+    ShmRingLayout* layout() const { return layout_; }
+
+    ShmRing requests() const { return ShmRing(&layout_->requests); }
+    ShmRing responses() const { return ShmRing(&layout_->responses); }
+
+private:
+    ShmRingLayout* layout_ = nullptr;
+    int fd_ = -1;
+};
+
+// Control socket handshake: the client sends its wait mode as one byte, the
+// server answers with one byte (0 = accepted) carrying the memfd.
+bool sendChannelFd(int socket_fd, int channel_fd, uint8_t status);
+int receiveChannelFd(int socket_fd, uint8_t& status);
+
+} // namespace hello
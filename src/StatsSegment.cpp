@@ -0,0 +1,121 @@
+#include "StatsSegment.h"
+#include <iostream>
+#include <cstring>
+#include <chrono>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hello {
+
+StatsSegment::~StatsSegment() {
+    close();
+}
+
+std::string StatsSegment::defaultName(uint16_t port) {
+    return "/gRpcSvr_stats_" + std::to_string(port);
+}
+
+bool StatsSegment::create(const std::string& name, uint32_t num_workers, uint16_t num_classes, uint16_t port,
+                          uint64_t publish_interval_ms) {
+    close();
+
+    // Start from a fresh object: truncating one that a predecessor (hot restart)
+    // still has mapped would fault its publisher
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create stats segment " << name << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(StatsSegmentLayout)) != 0) {
+        std::cerr << "Failed to size stats segment " << name << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* addr = mmap(nullptr, sizeof(StatsSegmentLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to map stats segment " << name << ": " << strerror(errno) << std::endl;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills, so every seq starts even and every counter at zero
+    layout_ = static_cast<StatsSegmentLayout*>(addr);
+    name_ = name;
+    owner_ = true;
+
+    auto& header = layout_->header;
+    header.version = StatsSegmentLayout::VERSION;
+    header.num_workers = num_workers < StatsSegmentLayout::MAX_WORKERS ? num_workers : StatsSegmentLayout::MAX_WORKERS;
+    header.num_classes = num_classes < StatsSegmentLayout::MAX_CLASSES ? num_classes : StatsSegmentLayout::MAX_CLASSES;
+    header.pid = getpid();
+    header.port = port;
+    header.start_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.publish_interval_ms = publish_interval_ms;
+
+    // Publish the magic last so viewers never attach to a half-initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header.magic = StatsSegmentLayout::MAGIC;
+    return true;
+}
+
+bool StatsSegment::attach(const std::string& name) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to open stats segment " << name << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(StatsSegmentLayout)) {
+        std::cerr << "Stats segment " << name << " is too small" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, sizeof(StatsSegmentLayout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to map stats segment " << name << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    layout_ = static_cast<StatsSegmentLayout*>(addr);
+    if (layout_->header.magic != StatsSegmentLayout::MAGIC ||
+        layout_->header.version != StatsSegmentLayout::VERSION) {
+        std::cerr << "Stats segment " << name << " has an unknown layout" << std::endl;
+        munmap(addr, sizeof(StatsSegmentLayout));
+        layout_ = nullptr;
+        return false;
+    }
+
+    name_ = name;
+    owner_ = false;
+    return true;
+}
+
+void StatsSegment::close() {
+    if (!layout_) {
+        return;
+    }
+
+    munmap(layout_, sizeof(StatsSegmentLayout));
+    layout_ = nullptr;
+
+    if (owner_) {
+        shm_unlink(name_.c_str());
+        owner_ = false;
+    }
+    name_.clear();
+}
+
+} // namespace hello
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace hello {
+
+// Shared-memory statistics layout published by EpollServer under /dev/shm.
+// Every section carries its own seqlock: the single writer bumps `seq` to an odd
+// value, copies the counters and bumps it back to even. Readers retry until they
+// see the same even value before and after their copy, so they never block the
+// publisher and never observe a torn section.
+struct StatsSegmentLayout {
+    static constexpr uint64_t MAGIC = 0x6752706353746174ULL; // "gRpcStat"
+    static constexpr uint32_t VERSION = 7;
+    static constexpr int MAX_WORKERS = 64;
+    static constexpr int MAX_CLASSES = 4;
+    static constexpr int LATENCY_BUCKETS = 40; // bucket i holds latencies in [2^(i-1), 2^i) ns
+
+    struct alignas(64) Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t num_workers;
+        int32_t pid;
+        uint16_t port;
+        uint16_t num_classes;
+        uint64_t start_time_ns;
+        uint64_t publish_interval_ms;
+    };
+
+    struct alignas(64) GlobalSection {
+        std::atomic<uint64_t> seq;
+        uint64_t publish_time_ns;
+        uint64_t total_connections;
+        uint64_t active_connections;
+        uint64_t total_requests;
+        uint64_t total_bytes_sent;
+        uint64_t total_bytes_received;
+        uint64_t epoll_events_processed;
+        uint64_t lock_free_allocations;
+        uint64_t cache_misses;
+        uint64_t numa_crossings;
+        uint64_t cpu_cycles;
+        uint64_t instructions;
+        uint64_t branch_misses;
+        uint64_t context_switches;
+        uint64_t response_cache_hits;
+        uint64_t response_cache_misses;
+        uint64_t requests_shed;
+        uint64_t requests_expired;
+        uint64_t late_responses_dropped;
+        uint64_t streams_reset;
+        uint64_t offloaded_requests;   // handlers run on the work-stealing executor
+        uint64_t executor_steals;
+        uint64_t executor_queue_depth;
+        uint32_t executor_threads;     // zero when every handler runs inline
+        uint64_t min_latency_ns;
+        uint64_t max_latency_ns;
+        uint64_t total_latency_ns;
+        uint64_t latency_count;
+    };
+
+    struct alignas(64) WorkerSection {
+        std::atomic<uint64_t> seq;
+        uint64_t publish_time_ns;
+        int32_t cpu_core;
+        uint32_t overloaded;      // admission control is shedding on this worker
+        uint64_t requests;
+        uint64_t requests_shed;
+        uint64_t events;
+        uint64_t bytes_received;
+        uint64_t bytes_sent;
+        uint64_t busy_ns;
+        uint64_t cycles;          // hardware counters, zero when unavailable
+        uint64_t instructions;
+        uint64_t cache_misses;
+        uint64_t branch_misses;
+        uint64_t context_switches;
+        uint64_t latency_buckets[LATENCY_BUCKETS];
+    };
+
+    // One priority lane (traffic class), summed over the workers serving it
+    struct alignas(64) ClassSection {
+        std::atomic<uint64_t> seq;
+        uint64_t publish_time_ns;
+        char name[16];
+        uint64_t requests;
+        uint64_t latency_buckets[LATENCY_BUCKETS]; // request arrival to response queued
+    };
+
+    Header header;
+    GlobalSection global;
+    WorkerSection workers[MAX_WORKERS];
+    ClassSection classes[MAX_CLASSES];
+};
+
+// Maps a latency to its log2 histogram bucket (0 ns -> bucket 0).
+inline int latencyBucket(uint64_t latency_ns) {
+    int bucket = latency_ns == 0 ? 0 : 64 - __builtin_clzll(latency_ns);
+    return bucket < StatsSegmentLayout::LATENCY_BUCKETS ? bucket : StatsSegmentLayout::LATENCY_BUCKETS - 1;
+}
+
+// Upper bound (exclusive) of a histogram bucket in nanoseconds.
+inline uint64_t latencyBucketUpperBound(int bucket) {
+    return bucket <= 0 ? 1 : (1ULL << bucket);
+}
+
+// Owner of the mapping. The server creates the segment read-write; viewers such
+// as gRpcSvr_top attach read-only and copy sections out through the seqlock.
+class StatsSegment {
+public:
+    StatsSegment() = default;
+    ~StatsSegment();
+
+    StatsSegment(const StatsSegment&) = delete;
+    StatsSegment& operator=(const StatsSegment&) = delete;
+
+    static std::string defaultName(uint16_t port);
+
+    bool create(const std::string& name, uint32_t num_workers, uint16_t num_classes, uint16_t port,
+                uint64_t publish_interval_ms);
+    bool attach(const std::string& name);
+    void close();
+
+    // Leave the name in place on close(): a hot-restart successor now owns it
+    void disown() { owner_ = false; }
+
+    bool isOpen() const { return layout_ != nullptr; }
+    const StatsSegmentLayout::Header& header() const { return layout_->header; }
+
+    // Writer side: only one thread may publish a given section.
+    template<typename Fill>
+    void publishGlobal(Fill&& fill) { writeSection(layout_->global, fill); }
+
+    template<typename Fill>
+    void publishWorker(int worker_id, Fill&& fill) { writeSection(layout_->workers[worker_id], fill); }
+
+    template<typename Fill>
+    void publishClass(int class_id, Fill&& fill) { writeSection(layout_->classes[class_id], fill); }
+
+    // Reader side: returns false if the writer kept the section busy.
+    bool readGlobal(StatsSegmentLayout::GlobalSection& out) const { return readSection(layout_->global, out); }
+    bool readWorker(int worker_id, StatsSegmentLayout::WorkerSection& out) const {
+        return readSection(layout_->workers[worker_id], out);
+    }
+    bool readClass(int class_id, StatsSegmentLayout::ClassSection& out) const {
+        return readSection(layout_->classes[class_id], out);
+    }
+
+private:
+    template<typename Section, typename Fill>
+    static void writeSection(Section& section, Fill& fill) {
+        uint64_t seq = section.seq.load(std::memory_order_relaxed);
+        section.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(section);
+        section.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    template<typename Section>
+    static bool readSection(const Section& section, Section& out) {
+        for (int attempt = 0; attempt < 1000; ++attempt) {
+            uint64_t before = section.seq.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            copyPayload(section, out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (section.seq.load(std::memory_order_relaxed) == before) {
+                out.seq.store(before, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Copies everything after the seq word; the atomic itself is not copyable.
+    template<typename Section>
+    static void copyPayload(const Section& from, Section& to) {
+        constexpr size_t offset = sizeof(std::atomic<uint64_t>);
+        __builtin_memcpy(reinterpret_cast<char*>(&to) + offset,
+                         reinterpret_cast<const char*>(&from) + offset,
+                         sizeof(Section) - offset);
+    }
+
+    StatsSegmentLayout* layout_ = nullptr;
+    std::string name_;
+    bool owner_ = false;
+};
+
+} // namespace hello
@@ -0,0 +1,407 @@
+#include "UdpFanout.h"
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+namespace hello {
+
+namespace {
+
+constexpr int SOCKET_BUFFER_BYTES = 4 * 1024 * 1024;
+
+// Payload bytes one GSO super-datagram may carry (IPv4 limit, rounded down)
+constexpr size_t MAX_GSO_BYTES = 65000;
+
+bool readVarint(const uint8_t* data, size_t size, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool parseAddress(const std::string& host, in_addr& address) {
+    return inet_pton(AF_INET, host.c_str(), &address) == 1;
+}
+
+} // namespace
+
+UdpPublisher::~UdpPublisher() {
+    close();
+}
+
+bool UdpPublisher::parseEndpoint(const std::string& endpoint, sockaddr_in& address) {
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon + 1 == endpoint.size()) {
+        return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    if (!parseAddress(endpoint.substr(0, colon), address.sin_addr)) {
+        return false;
+    }
+    int port = 0;
+    for (char c : endpoint.substr(colon + 1)) {
+        if (c < '0' || c > '9' || (port = port * 10 + (c - '0')) > 65535) {
+            return false;
+        }
+    }
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    return port != 0;
+}
+
+bool UdpPublisher::open(const Options& options) {
+    close();
+
+    if (options.destinations.empty() || options.destinations.size() > MAX_DESTINATIONS) {
+        std::cerr << "UDP publisher needs 1 to " << MAX_DESTINATIONS << " destinations" << std::endl;
+        return false;
+    }
+    destinations_.clear();
+    bool multicast = false;
+    for (const std::string& endpoint : options.destinations) {
+        sockaddr_in address;
+        if (!parseEndpoint(endpoint, address)) {
+            std::cerr << "Invalid UDP destination: " << endpoint << " (expected ipv4:port)" << std::endl;
+            return false;
+        }
+        multicast = multicast || IN_MULTICAST(ntohl(address.sin_addr.s_addr));
+        destinations_.push_back(address);
+    }
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        std::cerr << "Failed to create UDP publisher socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+    setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER_BYTES, sizeof(SOCKET_BUFFER_BYTES));
+
+    if (multicast) {
+        in_addr interface;
+        if (!parseAddress(options.multicast_interface, interface)) {
+            std::cerr << "Invalid multicast interface: " << options.multicast_interface << std::endl;
+            close();
+            return false;
+        }
+        unsigned char ttl = static_cast<unsigned char>(options.multicast_ttl);
+        unsigned char loop = 1;
+        if (setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0 ||
+            setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+            setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0) {
+            std::cerr << "Failed to set up multicast on " << options.multicast_interface << ": "
+                      << strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    // The per-send control message sets the real segment size; this only
+    // asks whether the kernel knows UDP_SEGMENT at all
+    gso_ = false;
+    if (options.gso) {
+        int probe = static_cast<int>(MAX_DATAGRAM);
+        if (setsockopt(fd_, SOL_UDP, UDP_SEGMENT, &probe, sizeof(probe)) == 0) {
+            probe = 0;
+            setsockopt(fd_, SOL_UDP, UDP_SEGMENT, &probe, sizeof(probe));
+            gso_ = true;
+        } else {
+            std::cerr << "Warning: UDP GSO unavailable (" << strerror(errno)
+                      << "), sending one datagram per update" << std::endl;
+        }
+    }
+
+    queued_ = 0;
+    return true;
+}
+
+void UdpPublisher::close() {
+    if (fd_ >= 0) {
+        flush();
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool UdpPublisher::publish(std::string_view name, int32_t age, uint64_t timestamp_us) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    size_t frame_size = HelloResponseTemplate::encodedSize(name, age);
+    size_t message_size = frame_size - HelloResponseTemplate::FRAME_HEADER_SIZE;
+    if (sizeof(UdpUpdateHeader) + message_size > MAX_DATAGRAM) {
+        return false;
+    }
+    if (queued_ == MAX_BATCH) {
+        flush();
+    }
+
+    // Encoded as the epoll server's frame, placed so the gRPC prefix starts
+    // right after our header; the header then overwrites the frame header
+    Slot& slot = slots_[queued_++];
+    HelloResponseTemplate::encode(slot.bytes.data() + sizeof(UdpUpdateHeader) - HelloResponseTemplate::FRAME_HEADER_SIZE,
+                                  name, age, timestamp_us);
+    UdpUpdateHeader header;
+    header.magic = UdpUpdateHeader::MAGIC;
+    header.message_size = static_cast<uint32_t>(message_size);
+    header.sequence = next_sequence_++;
+    memcpy(slot.bytes.data(), &header, sizeof(header));
+    slot.size = sizeof(UdpUpdateHeader) + message_size;
+    return true;
+}
+
+size_t UdpPublisher::flush() {
+    size_t updates = static_cast<size_t>(queued_);
+    if (updates == 0 || fd_ < 0) {
+        return 0;
+    }
+
+    if (gso_ && !sendSegmented()) {
+        std::cerr << "Warning: the kernel rejected UDP GSO (" << strerror(errno)
+                  << "), sending one datagram per update" << std::endl;
+        gso_ = false;
+        sendBatched();
+    } else if (!gso_) {
+        sendBatched();
+    }
+
+    stats_.updates += updates;
+    queued_ = 0;
+    return updates;
+}
+
+bool UdpPublisher::sendBatched() {
+    int count = 0;
+    for (int u = 0; u < queued_; ++u) {
+        iovecs_[u].iov_base = slots_[u].bytes.data();
+        iovecs_[u].iov_len = slots_[u].size;
+        for (sockaddr_in& destination : destinations_) {
+            msghdr& header = messages_[count++].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &destination;
+            header.msg_namelen = sizeof(destination);
+            header.msg_iov = &iovecs_[u];
+            header.msg_iovlen = 1;
+        }
+    }
+    return sendMessages(count);
+}
+
+bool UdpPublisher::sendSegmented() {
+    // Every segment but the last of a message must be exactly the segment
+    // size, so shorter updates are zero-padded (the header's message_size
+    // tells subscribers where an update ends)
+    size_t segment = 0;
+    for (int u = 0; u < queued_; ++u) {
+        segment = std::max(segment, slots_[u].size);
+    }
+    for (int u = 0; u < queued_; ++u) {
+        Slot& slot = slots_[u];
+        memset(slot.bytes.data() + slot.size, 0, segment - slot.size);
+        iovecs_[u].iov_base = slot.bytes.data();
+        iovecs_[u].iov_len = segment;
+    }
+
+    cmsghdr* control = reinterpret_cast<cmsghdr*>(gso_control_.data());
+    control->cmsg_level = SOL_UDP;
+    control->cmsg_type = UDP_SEGMENT;
+    control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t segment_size = static_cast<uint16_t>(segment);
+    memcpy(CMSG_DATA(control), &segment_size, sizeof(segment_size));
+
+    int per_message = static_cast<int>(std::min<size_t>(MAX_BATCH, MAX_GSO_BYTES / segment));
+    int count = 0;
+    for (int first = 0; first < queued_; first += per_message) {
+        int segments = std::min(per_message, queued_ - first);
+        iovecs_[first + segments - 1].iov_len = slots_[first + segments - 1].size;
+        for (sockaddr_in& destination : destinations_) {
+            msghdr& header = messages_[count++].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &destination;
+            header.msg_namelen = sizeof(destination);
+            header.msg_iov = &iovecs_[first];
+            header.msg_iovlen = segments;
+            header.msg_control = gso_control_.data();
+            header.msg_controllen = gso_control_.size();
+        }
+    }
+    return sendMessages(count);
+}
+
+bool UdpPublisher::sendMessages(int count) {
+    int sent = 0;
+    while (sent < count) {
+        int accepted = sendmmsg(fd_, messages_.data() + sent, count - sent, 0);
+        ++stats_.send_calls;
+        if (accepted < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // GSO refused up front: let the caller resend without it
+            bool gso_message = messages_[sent].msg_hdr.msg_control != nullptr;
+            if (gso_message && sent == 0 && (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP)) {
+                return false;
+            }
+            // Skip the datagram the kernel refused; the rest still go out
+            stats_.send_errors += messages_[sent].msg_hdr.msg_iovlen;
+            ++sent;
+            continue;
+        }
+        for (int i = sent; i < sent + accepted; ++i) {
+            stats_.datagrams += messages_[i].msg_hdr.msg_iovlen;
+        }
+        sent += accepted;
+    }
+    return true;
+}
+
+UdpSubscriber::~UdpSubscriber() {
+    close();
+}
+
+bool UdpSubscriber::open(uint16_t port, const std::string& group, const std::string& interface) {
+    close();
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        std::cerr << "Failed to create UDP subscriber socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    int opt = 1;
+    if (!group.empty()) {
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+    }
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_BYTES, sizeof(SOCKET_BUFFER_BYTES));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Failed to bind UDP subscriber to port " << port << ": " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    if (!group.empty()) {
+        ip_mreqn membership;
+        memset(&membership, 0, sizeof(membership));
+        if (!parseAddress(group, membership.imr_multiaddr) || !parseAddress(interface, membership.imr_address) ||
+            setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+            std::cerr << "Failed to join multicast group " << group << " on " << interface << ": "
+                      << strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    for (int i = 0; i < MAX_BATCH; ++i) {
+        iovecs_[i].iov_base = buffers_[i].data();
+        iovecs_[i].iov_len = buffers_[i].size();
+        memset(&messages_[i], 0, sizeof(messages_[i]));
+        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+        messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+    expected_sequence_ = 0;
+    return true;
+}
+
+void UdpSubscriber::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+int UdpSubscriber::receive(Update* updates, int timeout_ms) {
+    if (fd_ < 0) {
+        return -1;
+    }
+
+    int received = recvmmsg(fd_, messages_.data(), MAX_BATCH, MSG_DONTWAIT, nullptr);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        pollfd wait = {fd_, POLLIN, 0};
+        if (poll(&wait, 1, timeout_ms) <= 0) {
+            return 0;
+        }
+        received = recvmmsg(fd_, messages_.data(), MAX_BATCH, MSG_DONTWAIT, nullptr);
+    }
+    ++stats_.receive_calls;
+    if (received < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+
+    int decoded = 0;
+    for (int i = 0; i < received; ++i) {
+        ++stats_.datagrams;
+        if (!decode(buffers_[i].data(), messages_[i].msg_len, updates[decoded])) {
+            ++stats_.malformed;
+            continue;
+        }
+        trackSequence(updates[decoded].sequence);
+        ++stats_.updates;
+        ++decoded;
+    }
+    return decoded;
+}
+
+bool UdpSubscriber::decode(const uint8_t* data, size_t size, Update& update) {
+    UdpUpdateHeader header;
+    if (size < sizeof(header)) return false;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != UdpUpdateHeader::MAGIC || header.message_size > size - sizeof(header)) return false;
+
+    // gRPC prefix: uncompressed flag, then the message length
+    const uint8_t* prefix = data + sizeof(header);
+    if (header.message_size < 5 || prefix[0] != 0) return false;
+    size_t length = (static_cast<size_t>(prefix[1]) << 24) | (prefix[2] << 16) | (prefix[3] << 8) | prefix[4];
+    if (length > header.message_size - 5) return false;
+
+    const uint8_t* message = prefix + 5;
+    size_t pos = 0;
+    update.sequence = header.sequence;
+    update.message = std::string_view();
+    update.timestamp_us = 0;
+    while (pos < length) {
+        uint64_t tag;
+        if (!readVarint(message, length, pos, tag)) return false;
+        if (tag == ((1 << 3) | 2)) {
+            uint64_t text_size;
+            if (!readVarint(message, length, pos, text_size) || text_size > length - pos) return false;
+            update.message = std::string_view(reinterpret_cast<const char*>(message + pos), text_size);
+            pos += text_size;
+        } else if (tag == ((2 << 3) | 0)) {
+            if (!readVarint(message, length, pos, update.timestamp_us)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UdpSubscriber::trackSequence(uint64_t sequence) {
+    if (expected_sequence_ == 0 || sequence == expected_sequence_) {
+        expected_sequence_ = sequence + 1;
+    } else if (sequence > expected_sequence_) {
+        stats_.missing += sequence - expected_sequence_;
+        expected_sequence_ = sequence + 1;
+    } else {
+        ++stats_.out_of_order;
+    }
+}
+
+} // namespace hello
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "ResponseTemplate.h"
+
+namespace hello {
+
+// One update datagram: this header, then the gRPC length-prefixed
+// HelloResponse exactly as HelloResponseTemplate frames it for the epoll
+// server, minus the HTTP/2 frame header. Host byte order: the fan-out is
+// for subscribers on the same machine.
+struct UdpUpdateHeader {
+    static constexpr uint32_t MAGIC = 0x31505548; // "HUP1"
+
+    uint32_t magic;
+    uint32_t message_size; // bytes after the header: gRPC prefix + HelloResponse
+    uint64_t sequence;     // 1, 2, ... per publisher; a jump means lost datagrams
+};
+static_assert(sizeof(UdpUpdateHeader) == 16, "UdpUpdateHeader is part of the wire format");
+static_assert(sizeof(UdpUpdateHeader) >= HelloResponseTemplate::FRAME_HEADER_SIZE,
+              "the frame header is overwritten in place");
+
+// Market-data style fan-out of HelloResponse updates over UDP. Updates are
+// encoded straight into preallocated batch slots, and flush() sends every
+// queued update to every destination with a single sendmmsg. With GSO
+// (UDP_SEGMENT) each destination gets the batch as one super-datagram (more
+// past 64 KB) that the kernel splits, so a flush costs one traversal of the
+// stack per destination instead of one per datagram. Multicast destinations
+// go out on multicast_interface, loopback by default.
+//
+// Not thread-safe: one thread publishes and flushes.
+class UdpPublisher {
+public:
+    static constexpr int MAX_BATCH = 64;
+    static constexpr int MAX_DESTINATIONS = 16;
+    static constexpr size_t MAX_DATAGRAM = 1024;
+
+    struct Options {
+        std::vector<std::string> destinations; // "host:port", unicast or multicast group
+        std::string multicast_interface = "127.0.0.1";
+        int multicast_ttl = 0; // 0 = this host only
+        bool gso = false;
+    };
+
+    struct Stats {
+        uint64_t updates = 0;     // updates flushed
+        uint64_t datagrams = 0;   // updates x destinations accepted by the kernel
+        uint64_t send_calls = 0;  // sendmmsg calls
+        uint64_t send_errors = 0; // datagrams the kernel refused
+    };
+
+    UdpPublisher() = default;
+    ~UdpPublisher();
+
+    UdpPublisher(const UdpPublisher&) = delete;
+    UdpPublisher& operator=(const UdpPublisher&) = delete;
+
+    bool open(const Options& options);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    // False when GSO was not asked for, or the kernel does not support it
+    bool gsoActive() const { return gso_; }
+
+    // Queues the SayHello greeting for name and age; flushes first when the
+    // batch is full. False if the update would not fit a datagram
+    bool publish(std::string_view name, int32_t age, uint64_t timestamp_us);
+
+    // Sends the queued updates to every destination; returns how many
+    // updates were queued
+    size_t flush();
+
+    const Stats& stats() const { return stats_; }
+
+    // "host:port" with a numeric IPv4 host; false if malformed
+    static bool parseEndpoint(const std::string& endpoint, sockaddr_in& address);
+
+private:
+    struct alignas(64) Slot {
+        std::array<uint8_t, MAX_DATAGRAM> bytes;
+        size_t size;
+    };
+
+    // One message per update and destination, or with GSO one per batch
+    // chunk and destination; false when the kernel rejected GSO
+    bool sendBatched();
+    bool sendSegmented();
+    bool sendMessages(int count);
+
+    int fd_ = -1;
+    bool gso_ = false;
+    uint64_t next_sequence_ = 1;
+    std::vector<sockaddr_in> destinations_;
+    std::array<Slot, MAX_BATCH> slots_;
+    int queued_ = 0;
+    Stats stats_;
+
+    // sendmmsg arguments, built in place on every flush; with GSO every
+    // message carries the same UDP_SEGMENT control message
+    std::array<mmsghdr, MAX_BATCH * MAX_DESTINATIONS> messages_;
+    std::array<iovec, MAX_BATCH> iovecs_;
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(uint16_t))> gso_control_;
+};
+
+// Receiving side: one recvmmsg takes up to MAX_BATCH datagrams, and the
+// sequence numbers are checked for gaps (lost datagrams) and for
+// datagrams arriving late or twice.
+class UdpSubscriber {
+public:
+    static constexpr int MAX_BATCH = 64;
+
+    struct Update {
+        uint64_t sequence;
+        std::string_view message; // HelloResponse.message, valid until the next receive()
+        uint64_t timestamp_us;    // HelloResponse.timestamp
+    };
+
+    struct Stats {
+        uint64_t datagrams = 0;
+        uint64_t updates = 0;
+        uint64_t missing = 0;      // sequence numbers skipped over
+        uint64_t out_of_order = 0; // older than one already seen: late or duplicated
+        uint64_t malformed = 0;
+        uint64_t receive_calls = 0;
+    };
+
+    UdpSubscriber() = default;
+    ~UdpSubscriber();
+
+    UdpSubscriber(const UdpSubscriber&) = delete;
+    UdpSubscriber& operator=(const UdpSubscriber&) = delete;
+
+    // Binds port on all addresses; with a group, also joins it on interface.
+    // Several subscribers may share a multicast port
+    bool open(uint16_t port, const std::string& group = "", const std::string& interface = "127.0.0.1");
+    void close();
+
+    // Waits up to timeout_ms for datagrams and decodes up to MAX_BATCH of
+    // them into updates; returns how many (0 on timeout, -1 on error)
+    int receive(Update* updates, int timeout_ms);
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 2048;
+
+    bool decode(const uint8_t* data, size_t size, Update& update);
+    void trackSequence(uint64_t sequence);
+
+    int fd_ = -1;
+    uint64_t expected_sequence_ = 0; // 0 = nothing received yet
+    Stats stats_;
+    std::array<std::array<uint8_t, BUFFER_SIZE>, MAX_BATCH> buffers_;
+    std::array<mmsghdr, MAX_BATCH> messages_;
+    std::array<iovec, MAX_BATCH> iovecs_;
+};
+
+} // namespace hello
@@ -0,0 +1,177 @@
+#include "WorkStealingExecutor.h"
+#include <climits>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hello {
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, uint64_t timeout_us) {
+    struct timespec timeout;
+    timeout.tv_sec = timeout_us / 1000000;
+    timeout.tv_nsec = (timeout_us % 1000000) * 1000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    stop();
+}
+
+bool WorkStealingExecutor::start(int threads, int num_queues, const std::vector<int>& cpu_cores) {
+    if (running_.load() || threads <= 0 || num_queues <= 0) {
+        return false;
+    }
+
+    queues_.clear();
+    for (int i = 0; i < num_queues; ++i) {
+        queues_.push_back(std::make_unique<ChaseLevDeque<ExecutorTask, QUEUE_CAPACITY>>());
+    }
+
+    running_.store(true);
+    executors_.clear();
+    for (int i = 0; i < threads; ++i) {
+        executors_.push_back(std::make_unique<Executor>());
+    }
+    for (int i = 0; i < threads; ++i) {
+        int cpu_core = cpu_cores.empty() ? -1 : cpu_cores[i % cpu_cores.size()];
+        executors_[i]->thread = std::thread(&WorkStealingExecutor::executorThread, this, i, cpu_core);
+    }
+    return true;
+}
+
+void WorkStealingExecutor::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    futexWake(&epoch_, INT_MAX);
+    for (auto& executor : executors_) {
+        if (executor->thread.joinable()) {
+            executor->thread.join();
+        }
+    }
+}
+
+bool WorkStealingExecutor::submit(int queue, ExecutorTask* task) {
+    if (!running_.load(std::memory_order_relaxed) || !queues_[queue]->push(task)) {
+        return false;
+    }
+
+    // Pairs with the sleeper announcing itself before its last look at the
+    // queues: either it sees this task or we see it and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        futexWake(&epoch_, 1);
+    }
+    return true;
+}
+
+WorkStealingExecutor::Stats WorkStealingExecutor::stats() const {
+    Stats stats;
+    for (const auto& executor : executors_) {
+        stats.executed += executor->executed.load(std::memory_order_relaxed);
+        stats.steals += executor->steals.load(std::memory_order_relaxed);
+    }
+    for (const auto& queue : queues_) {
+        stats.queue_depth += queue->size();
+    }
+    return stats;
+}
+
+bool WorkStealingExecutor::hasQueuedTasks() const {
+    for (const auto& queue : queues_) {
+        if (queue->size() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ExecutorTask* WorkStealingExecutor::findTask(int id, bool& stolen) {
+    int threads = static_cast<int>(executors_.size());
+    int num_queues = static_cast<int>(queues_.size());
+
+    // Home queues first, oldest task first
+    for (int queue = id; queue < num_queues; queue += threads) {
+        if (ExecutorTask* task = queues_[queue]->steal()) {
+            stolen = false;
+            return task;
+        }
+    }
+
+    // Then everyone else's, starting after our own so thieves spread out
+    for (int offset = 1; offset < num_queues; ++offset) {
+        int queue = (id + offset) % num_queues;
+        if (queue % threads == id) {
+            continue;
+        }
+        if (ExecutorTask* task = queues_[queue]->steal()) {
+            stolen = true;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingExecutor::executorThread(int id, int cpu_core) {
+    if (cpu_core >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu_core, &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    }
+
+    Executor& self = *executors_[id];
+    int idle_spins = 0;
+    while (true) {
+        bool stolen = false;
+        if (ExecutorTask* task = findTask(id, stolen)) {
+            task->run(task);
+            self.executed.store(self.executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (stolen) {
+                self.steals.store(self.steals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            idle_spins = 0;
+            continue;
+        }
+
+        // Stopping: the queues are empty, nothing is left to finish
+        if (!running_.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        if (++idle_spins < SPIN_LIMIT) {
+            cpuRelax();
+            continue;
+        }
+        idle_spins = 0;
+
+        uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if (!hasQueuedTasks() && running_.load(std::memory_order_relaxed)) {
+            futexWait(&epoch_, epoch, IDLE_SLEEP_US);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace hello
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace hello {
+
+// Unit of work for WorkStealingExecutor and MpscQueue. Intrusive, so queuing
+// a task never allocates: callers derive from it and point run at a function
+// that casts back to their type.
+struct ExecutorTask {
+    std::atomic<ExecutorTask*> next{nullptr};
+    void (*run)(ExecutorTask* task) = nullptr;
+};
+
+// Chase-Lev work-stealing deque with a fixed power-of-two capacity. One owner
+// thread pushes at the bottom; any thread steals from the top, oldest first,
+// with a single CAS. (The owner-side LIFO pop of the original algorithm is
+// left out: owners here only produce.)
+template<typename T, size_t Capacity>
+class ChaseLevDeque {
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Owner only; false when full
+    bool push(T* item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(Capacity)) {
+            return false;
+        }
+        buffer_[bottom & (Capacity - 1)].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Any thread; nullptr when empty or when another thief won the race
+    T* steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        T* item = buffer_[top & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    size_t size() const {
+        int64_t depth = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+        return depth > 0 ? static_cast<size_t>(depth) : 0;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::array<std::atomic<T*>, Capacity> buffer_{};
+};
+
+// Vyukov's intrusive multi-producer / single-consumer queue: producers take
+// one exchange each and never wait; the consumer needs no atomic RMW at all.
+// pop() can briefly return nullptr while a producer is between its two
+// stores, so producers signal the consumer after push() returns.
+template<typename Node>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread
+    void push(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only
+    Node* pop() {
+        Node* tail = tail_;
+        Node* next = static_cast<Node*>(tail->next.load(std::memory_order_acquire));
+        if (tail == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            tail_ = next;
+            tail = next;
+            next = static_cast<Node*>(next->next.load(std::memory_order_acquire));
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr; // a producer is mid-push
+        }
+        push(&stub_);
+        next = static_cast<Node*>(tail->next.load(std::memory_order_acquire));
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) Node* tail_;
+    Node stub_;
+};
+
+// Executor threads for handlers too expensive to run on an I/O thread. Each
+// submitting thread owns one ChaseLevDeque and pushes into it; every
+// executor thread takes first from the deques it is home to (queue %
+// threads) and, when those are empty, steals from the others. A slow task
+// therefore only delays the tasks queued behind it until an idle executor
+// steals them. Idle executors spin briefly, then sleep on a futex until a
+// submit wakes them.
+class WorkStealingExecutor {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 256;
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t steals = 0;      // tasks taken from another executor's home queue
+        size_t queue_depth = 0;   // tasks waiting, summed over all queues
+    };
+
+    WorkStealingExecutor() = default;
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    // threads executor threads pinned round-robin to cpu_cores (empty = not
+    // pinned), serving num_queues submitting threads
+    bool start(int threads, int num_queues, const std::vector<int>& cpu_cores);
+
+    // Once every submitting thread has stopped: runs whatever is still
+    // queued, then joins the executor threads
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+    int threadCount() const { return static_cast<int>(executors_.size()); }
+
+    // Only the thread owning queue may submit to it; false when the queue is
+    // full or the executor is not running (the caller runs the task itself)
+    bool submit(int queue, ExecutorTask* task);
+
+    Stats stats() const;
+
+    static constexpr int SPIN_LIMIT = 256;
+    static constexpr uint64_t IDLE_SLEEP_US = 1000;
+
+private:
+    struct alignas(64) Executor {
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> steals{0};
+        std::thread thread;
+    };
+
+    void executorThread(int id, int cpu_core);
+    ExecutorTask* findTask(int id, bool& stolen);
+    bool hasQueuedTasks() const;
+
+    std::vector<std::unique_ptr<ChaseLevDeque<ExecutorTask, QUEUE_CAPACITY>>> queues_;
+    std::vector<std::unique_ptr<Executor>> executors_;
+    std::atomic<bool> running_{false};
+
+    // Eventcount for idle executors: submitters bump the epoch and wake a
+    // sleeper only when one has announced itself
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    alignas(64) std::atomic<int> sleepers_{0};
+};
+
+} // namespace hello
@@ -0,0 +1,207 @@
+#include "ServerManager.h"
+#include "HelloService.h"
+#include "HelloService.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <cstdlib>
+
+// Counts heap allocations of the SayHello/SayHelloStream response formatting on
+// reused messages, then per unary SayHello RPC with the synchronous handler
+// (heap messages) and with the callback handler using pooled protobuf arenas.
+// malloc and friends are interposed and forwarded to glibc; the client runs on
+// the main thread so its own allocations can be separated from the server's.
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocated_bytes{0};
+std::atomic<uint64_t> g_client_allocations{0};
+thread_local bool t_client_thread = false;
+
+inline void countAllocation(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (t_client_thread) {
+        g_client_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    countAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    countAllocation(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+}
+
+namespace {
+
+struct Result {
+    double server_allocations_per_rpc;
+    double client_allocations_per_rpc;
+    double bytes_per_rpc;
+    int failures;
+};
+
+// Allocations per call of the handlers' response builders, on response
+// objects that are reused the way arena holders and stream reactors reuse them
+void runHandlerFormatting(int calls) {
+    hello::HelloRequest request;
+    request.set_name("AllocationBenchmarkClient");
+    request.set_age(42);
+    hello::HelloResponse unary;
+    hello::HelloResponse stream;
+
+    // Warm up the thread-local buffer and the messages' capacity
+    hello::HelloServiceImpl::buildHelloResponse(request, &unary);
+    hello::HelloServiceImpl::buildStreamResponse(request, 1000, &stream);
+
+    uint64_t before = g_allocations.load();
+    for (int i = 0; i < calls; ++i) {
+        hello::HelloServiceImpl::buildHelloResponse(request, &unary);
+    }
+    uint64_t unary_allocations = g_allocations.load() - before;
+
+    before = g_allocations.load();
+    for (int i = 0; i < calls; ++i) {
+        hello::HelloServiceImpl::buildStreamResponse(request, i % 1000 + 1, &stream);
+    }
+    uint64_t stream_allocations = g_allocations.load() - before;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Handler formatting (" << calls << " calls each):" << std::endl;
+    std::cout << "  SayHello response:        " << static_cast<double>(unary_allocations) / calls
+              << " allocations/call" << std::endl;
+    std::cout << "  SayHelloStream message:   " << static_cast<double>(stream_allocations) / calls
+              << " allocations/call" << std::endl;
+}
+
+bool runMode(const std::string& address, bool arena, int requests, Result& result) {
+    auto& manager = hello::ServerManager::getInstance();
+
+    // No log interceptor, so only the handler path is measured
+    hello::LoggingPolicy quiet;
+    quiet.sample_one_in = 0;
+    quiet.always_log_errors = false;
+    manager.setLoggingPolicy(quiet);
+
+    hello::ServerManager::Options options;
+    options.arena_messages = arena;
+    if (!manager.startServer(address, options)) {
+        return false;
+    }
+
+    auto stub = hello::HelloService::NewStub(grpc::CreateChannel(address, grpc::InsecureChannelCredentials()));
+    hello::HelloRequest request;
+    request.set_name("AllocationBenchmarkClient");
+    request.set_age(42);
+
+    auto call = [&]() {
+        hello::HelloResponse response;
+        grpc::ClientContext context;
+        return stub->SayHello(&context, request, &response).ok();
+    };
+
+    // Warm up channel, thread pools and the arena holder caches
+    for (int i = 0; i < requests / 10 + 100; ++i) {
+        call();
+    }
+
+    uint64_t allocations_before = g_allocations.load();
+    uint64_t bytes_before = g_allocated_bytes.load();
+    uint64_t client_before = g_client_allocations.load();
+
+    result.failures = 0;
+    for (int i = 0; i < requests; ++i) {
+        if (!call()) ++result.failures;
+    }
+
+    uint64_t allocations = g_allocations.load() - allocations_before;
+    uint64_t client_allocations = g_client_allocations.load() - client_before;
+    result.server_allocations_per_rpc = static_cast<double>(allocations - client_allocations) / requests;
+    result.client_allocations_per_rpc = static_cast<double>(client_allocations) / requests;
+    result.bytes_per_rpc = static_cast<double>(g_allocated_bytes.load() - bytes_before) / requests;
+
+    stub.reset();
+    manager.stopServer();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int requests = argc > 1 ? std::atoi(argv[1]) : 5000;
+    std::string address = argc > 2 ? argv[2] : "127.0.0.1:50061";
+    if (requests <= 0) {
+        std::cout << "Usage: " << argv[0] << " [requests] [address]" << std::endl;
+        return 1;
+    }
+
+    t_client_thread = true;
+
+    std::cout << "🚀 Allocation Benchmark: heap vs arena messages (" << requests << " unary RPCs)" << std::endl;
+    std::cout << "==========================================================" << std::endl;
+
+    runHandlerFormatting(requests * 10);
+
+    Result heap_result;
+    Result arena_result;
+    if (!runMode(address, false, requests, heap_result) || !runMode(address, true, requests, arena_result)) {
+        std::cerr << "Failed to start server on " << address << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::left << std::setw(24) << "MODE" << std::right
+              << std::setw(20) << "SERVER MALLOC/RPC" << std::setw(20) << "CLIENT MALLOC/RPC"
+              << std::setw(16) << "BYTES/RPC" << std::setw(10) << "FAILED" << std::endl;
+
+    auto printRow = [](const char* name, const Result& r) {
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::setw(20) << r.server_allocations_per_rpc
+                  << std::setw(20) << r.client_allocations_per_rpc
+                  << std::setw(16) << r.bytes_per_rpc
+                  << std::setw(10) << r.failures << std::endl;
+    };
+    printRow("sync, heap messages", heap_result);
+    printRow("callback, arena", arena_result);
+
+    double saved = heap_result.server_allocations_per_rpc - arena_result.server_allocations_per_rpc;
+    std::cout << "\nServer-side allocations saved per RPC: " << saved << std::endl;
+    std::cout << "(server column counts every thread except the client's, including gRPC internals)" << std::endl;
+    return 0;
+}
@@ -12,10 +12,13 @@
 #include <sstream>
 #include <cstring>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/time.h>
 
 class EpollPerformanceTest {
 private:
@@ -26,11 +29,30 @@ public:
     EpollPerformanceTest(const std::string& address, uint16_t port) 
         : serverAddress_(address), serverPort_(port) {}
     
-    // Single request latency test
-    double measureSingleLatency() {
+    // Connects over TCP, or over a Unix domain socket for a "unix:<path>" address
+    int connectToServer() {
+        static const std::string unixPrefix = "unix:";
+        if (serverAddress_.compare(0, unixPrefix.size(), unixPrefix) == 0) {
+            std::string path = serverAddress_.substr(unixPrefix.size());
+            struct sockaddr_un server_addr;
+            memset(&server_addr, 0, sizeof(server_addr));
+            server_addr.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(server_addr.sun_path)) {
+                return -1;
+            }
+            memcpy(server_addr.sun_path, path.c_str(), path.size() + 1);
+            
+            int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (sock >= 0 && connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
+                close(sock);
+                return -1;
+            }
+            return sock;
+        }
+        
         int sock = socket(AF_INET, SOCK_STREAM, 0);
         if (sock < 0) {
-            return -1.0;
+            return -1;
         }
         
         struct sockaddr_in server_addr;
@@ -41,6 +63,15 @@ public:
         
         if (connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
             close(sock);
+            return -1;
+        }
+        return sock;
+    }
+    
+    // Single request latency test
+    double measureSingleLatency() {
+        int sock = connectToServer();
+        if (sock < 0) {
             return -1.0;
         }
         
@@ -63,7 +94,9 @@ public:
         
         close(sock);
         
-        if (received < 0) {
+        // Only a DATA frame carries a greeting; a HEADERS frame here is a
+        // trailers-only error status
+        if (received < 9 || buffer[3] != 0) {
             return -1.0;
         }
         
@@ -71,6 +104,37 @@ public:
         return duration.count() / 1000.0; // Convert to milliseconds
     }
     
+    // Protocol checks: the answers the timing tests rely on
+    bool runProtocolChecks() {
+        bool passed = true;
+        
+        // A greeting goes back on the stream of its request, whether freshly
+        // encoded or copied from the server's response cache
+        for (uint32_t stream_id : {3, 5, 7}) {
+            if (expectGreeting(createHelloRequest(stream_id, "Alice", 30), stream_id, "Hello, Alice")) {
+                std::cout << "✅ SayHello on stream " << stream_id << " answered on its stream" << std::endl;
+            } else {
+                std::cout << "❌ SayHello on stream " << stream_id << " not answered on its stream" << std::endl;
+                passed = false;
+            }
+        }
+        
+        // A request split by TCP between its HEADERS and DATA, or inside the
+        // DATA, is answered once its DATA arrives, with the name it carries
+        std::vector<uint8_t> request = createHelloRequest(1, "Alice", 30);
+        size_t headers_size = 9 + ((request[0] << 16) | (request[1] << 8) | request[2]);
+        for (size_t split : {headers_size, headers_size + 12}) {
+            if (expectGreeting(request, 1, "Hello, Alice", split)) {
+                std::cout << "✅ SayHello split at byte " << split << " answered as one request" << std::endl;
+            } else {
+                std::cout << "❌ SayHello split at byte " << split << " not answered as one request" << std::endl;
+                passed = false;
+            }
+        }
+        
+        return passed;
+    }
+    
     // Warmup function
     void warmup(int iterations = 10) {
         std::cout << "Warming up epoll server with " << iterations << " requests..." << std::endl;
@@ -195,26 +259,110 @@ private:
     std::vector<uint8_t> createHttp2HeadersFrame() {
         std::vector<uint8_t> frame;
         
+        // Headers payload (simplified)
+        std::string headers = ":method: POST\r\n:path: /hello.HelloService/SayHello\r\n";
+        
         // HTTP/2 HEADERS frame (simplified)
         // Frame header (9 bytes)
-        uint32_t payload_length = 32; // Approximate headers length
+        uint32_t payload_length = headers.size();
         frame.push_back((payload_length >> 16) & 0xFF);
         frame.push_back((payload_length >> 8) & 0xFF);
         frame.push_back(payload_length & 0xFF);
         frame.push_back(1); // HEADERS frame type
-        frame.push_back(0x04); // END_HEADERS flag
+        frame.push_back(0x05); // END_STREAM | END_HEADERS: no DATA follows
         frame.push_back(0); // Stream ID (1)
         frame.push_back(0);
         frame.push_back(0);
         frame.push_back(1);
         
-        // Headers payload (simplified)
-        std::string headers = ":method: POST\r\n:path: /hello.HelloService/SayHello\r\n";
         frame.insert(frame.end(), headers.begin(), headers.end());
         
         return frame;
     }
     
+    static void appendFrame(std::vector<uint8_t>& out, uint8_t type, uint8_t flags, uint32_t stream_id,
+                            const std::string& payload) {
+        out.push_back((payload.size() >> 16) & 0xFF);
+        out.push_back((payload.size() >> 8) & 0xFF);
+        out.push_back(payload.size() & 0xFF);
+        out.push_back(type);
+        out.push_back(flags);
+        out.push_back((stream_id >> 24) & 0x7F);
+        out.push_back((stream_id >> 16) & 0xFF);
+        out.push_back((stream_id >> 8) & 0xFF);
+        out.push_back(stream_id & 0xFF);
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    
+    // HEADERS then a DATA frame holding HelloRequest{name, age}
+    std::vector<uint8_t> createHelloRequest(uint32_t stream_id, const std::string& name, uint8_t age) {
+        std::string message;
+        message += '\x0a';
+        message += static_cast<char>(name.size());
+        message += name;
+        message += '\x10';
+        message += static_cast<char>(age);
+        
+        std::string data(5, '\0'); // uncompressed, 4-byte length
+        data[4] = static_cast<char>(message.size());
+        data += message;
+        
+        std::vector<uint8_t> request;
+        appendFrame(request, 1, 0x04, stream_id, ":method: POST\r\n:path: /hello.HelloService/SayHello\r\n"); // END_HEADERS
+        appendFrame(request, 0, 0x01, stream_id, data); // END_STREAM
+        return request;
+    }
+    
+    // Reads one whole frame; false on timeout or a closed connection
+    static bool readFrame(int sock, std::vector<uint8_t>& frame) {
+        frame.assign(9, 0);
+        size_t have = 0;
+        while (have < frame.size()) {
+            ssize_t received = recv(sock, frame.data() + have, frame.size() - have, 0);
+            if (received <= 0) {
+                return false;
+            }
+            have += received;
+            if (have == 9 && frame.size() == 9) {
+                frame.resize(9 + ((frame[0] << 16) | (frame[1] << 8) | frame[2]));
+            }
+        }
+        return true;
+    }
+    
+    // Sends request and expects a DATA frame on stream_id containing greeting.
+    // A non-zero split sends the first split bytes on their own, then the rest
+    bool expectGreeting(const std::vector<uint8_t>& request, uint32_t stream_id, const std::string& greeting,
+                        size_t split = 0) {
+        int sock = connectToServer();
+        if (sock < 0) {
+            return false;
+        }
+        struct timeval timeout = {1, 0};
+        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        int nodelay = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        
+        size_t first = split > 0 && split < request.size() ? split : request.size();
+        bool sent = send(sock, request.data(), first, 0) == static_cast<ssize_t>(first);
+        if (sent && first < request.size()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            sent = send(sock, request.data() + first, request.size() - first, 0) ==
+                   static_cast<ssize_t>(request.size() - first);
+        }
+        
+        std::vector<uint8_t> frame;
+        bool answered = sent && readFrame(sock, frame);
+        close(sock);
+        if (!answered || frame[3] != 0) {
+            return false;
+        }
+        
+        uint32_t frame_stream = ((frame[5] & 0x7F) << 24) | (frame[6] << 16) | (frame[7] << 8) | frame[8];
+        std::string payload(frame.begin() + 9, frame.end());
+        return frame_stream == stream_id && payload.find(greeting) != std::string::npos;
+    }
+    
     void saveDetailedResults(const std::vector<double>& latencies, double avgLatency, 
                            double throughput, int completed, int failed) {
         std::ofstream file("epoll_performance_report.txt");
@@ -243,16 +391,24 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "🚀 Epoll Server Performance Test" << std::endl;
     std::cout << "================================" << std::endl;
     
-    const std::string serverAddress = "127.0.0.1";
+    // Optional target: an IPv4 address on port 50052, or unix:<path> for --uds servers
+    const std::string serverAddress = argc > 1 ? argv[1] : "127.0.0.1";
     const uint16_t serverPort = 50052;
     
     try {
         EpollPerformanceTest test(serverAddress, serverPort);
         
+        // Answers must be right before their timings mean anything
+        std::cout << "\n🔎 Protocol checks" << std::endl;
+        if (!test.runProtocolChecks()) {
+            std::cerr << "❌ Protocol checks failed" << std::endl;
+            return 1;
+        }
+        
         // Run different performance tests
         std::cout << "\n🔍 Running epoll server performance tests..." << std::endl;
         
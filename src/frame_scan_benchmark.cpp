@@ -0,0 +1,220 @@
+#include "FrameScanner.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+// Cost of FrameScanner on full 16 KB receive buffers, per instruction set:
+// frame walk plus classification of a buffer of pipelined unary requests
+// and of a buffer of tiny frames, and header lookups in the request header
+// blocks against the substring search findHeader used before. Every vector
+// result is checked against the scalar scanner first.
+class FrameScanBenchmark {
+private:
+    static constexpr size_t BUFFER_SIZE = 16384;
+
+    std::vector<uint8_t> requests_;
+    std::vector<uint8_t> tiny_frames_;
+    std::vector<std::string_view> header_blocks_;
+    hello::FrameBatch batch_;
+    hello::FrameBatch reference_;
+    uint64_t sink_ = 0;
+
+public:
+    FrameScanBenchmark() {
+        // HEADERS + DATA per request, on ascending client stream ids
+        const std::string headers = ":method: POST\r\n:path: /hello.HelloService/SayHello\r\n"
+                                    "content-type: application/grpc\r\ngrpc-timeout: 100m\r\n";
+        const std::string name = "FrameScanBenchmark";
+        std::vector<uint8_t> message = {0x0A, static_cast<uint8_t>(name.size())};
+        message.insert(message.end(), name.begin(), name.end());
+        message.push_back(0x10);
+        message.push_back(25);
+
+        uint32_t stream_id = 1;
+        while (requests_.size() + 18 + headers.size() + 5 + message.size() <= BUFFER_SIZE) {
+            std::vector<uint8_t> body(headers.begin(), headers.end());
+            appendFrame(requests_, 1, 0x04, stream_id, body);
+            std::vector<uint8_t> data = {0x00, 0x00, 0x00, 0x00, static_cast<uint8_t>(message.size())};
+            data.insert(data.end(), message.begin(), message.end());
+            appendFrame(requests_, 0, 0x01, stream_id, data);
+            stream_id += 2;
+        }
+
+        // WINDOW_UPDATE frames: 13 bytes each, the worst case for the walk
+        std::vector<uint8_t> increment = {0x00, 0x00, 0x10, 0x00};
+        while (tiny_frames_.size() + 9 + increment.size() <= BUFFER_SIZE) {
+            appendFrame(tiny_frames_, 8, 0, 0, increment);
+        }
+
+        size_t pos = 0;
+        while (pos + 9 <= requests_.size()) {
+            size_t length = (static_cast<size_t>(requests_[pos]) << 16) | (requests_[pos + 1] << 8) | requests_[pos + 2];
+            if (requests_[pos + 3] == 1) {
+                header_blocks_.emplace_back(reinterpret_cast<const char*>(requests_.data()) + pos + 9, length);
+            }
+            pos += 9 + length;
+        }
+    }
+
+    bool runTest(int iterations) {
+        std::cout << "=== HTTP/2 Frame Scanner Benchmark ===" << std::endl;
+        std::cout << "Buffer: " << BUFFER_SIZE << " bytes, iterations: " << iterations << std::endl;
+        std::cout << "Best instruction set: " << hello::FrameScanner::isaName(hello::FrameScanner::detect()) << std::endl;
+        std::cout << "======================================" << std::endl;
+
+        const hello::FrameScanner::Isa isas[] = {hello::FrameScanner::Isa::Scalar, hello::FrameScanner::Isa::Sse42,
+                                                 hello::FrameScanner::Isa::Avx2};
+
+        for (const auto& [label, buffer] : {std::make_pair("Pipelined requests", &requests_),
+                                            std::make_pair("Tiny frames", &tiny_frames_)}) {
+            hello::FrameScanner scalar(hello::FrameScanner::Isa::Scalar);
+            scalar.scan(buffer->data(), buffer->size(), reference_);
+            std::cout << "\n" << label << " (" << reference_.count << " frames, "
+                      << countSegments(reference_) << " segments):" << std::endl;
+
+            for (auto isa : isas) {
+                if (!hello::FrameScanner::supported(isa)) {
+                    std::cout << "  " << std::setw(7) << hello::FrameScanner::isaName(isa) << ": not supported" << std::endl;
+                    continue;
+                }
+                hello::FrameScanner scanner(isa);
+                scanner.scan(buffer->data(), buffer->size(), batch_);
+                if (!sameBatch(batch_, reference_)) {
+                    std::cerr << hello::FrameScanner::isaName(isa) << " scan differs from scalar" << std::endl;
+                    return false;
+                }
+
+                double ns = timePerCall(iterations, [&]() {
+                    sink_ += scanner.scan(buffer->data(), buffer->size(), batch_) + batch_.segment_starts[0];
+                });
+                std::cout << "  " << std::setw(7) << hello::FrameScanner::isaName(isa) << ": "
+                          << std::fixed << std::setprecision(1) << ns << " ns/buffer, "
+                          << std::setprecision(2) << ns / reference_.count << " ns/frame" << std::endl;
+            }
+        }
+
+        std::cout << "\nHeader lookups (:path, grpc-timeout, absent x-priority) in "
+                  << header_blocks_.size() << " header blocks:" << std::endl;
+        const std::string_view names[] = {":path:", "grpc-timeout:", "x-priority:"};
+        double ns = timePerCall(iterations / 10 + 1, [&]() {
+            for (std::string_view block : header_blocks_) {
+                for (std::string_view name : names) {
+                    std::string_view value;
+                    if (substringSearch(block, name, value)) sink_ += value.size();
+                }
+            }
+        });
+        printLookups("substr", ns);
+
+        for (auto isa : isas) {
+            if (!hello::FrameScanner::supported(isa)) continue;
+            hello::FrameScanner scanner(isa);
+            for (std::string_view block : header_blocks_) {
+                for (std::string_view name : names) {
+                    std::string_view expected;
+                    std::string_view value;
+                    bool found = substringSearch(block, name, expected);
+                    if (scanner.findHeaderLine(block, name, value) != found || (found && value != expected)) {
+                        std::cerr << hello::FrameScanner::isaName(isa) << " lookup of " << name << " differs" << std::endl;
+                        return false;
+                    }
+                }
+            }
+            ns = timePerCall(iterations / 10 + 1, [&]() {
+                for (std::string_view block : header_blocks_) {
+                    for (std::string_view name : names) {
+                        std::string_view value;
+                        if (scanner.findHeaderLine(block, name, value)) sink_ += value.size();
+                    }
+                }
+            });
+            printLookups(hello::FrameScanner::isaName(isa), ns);
+        }
+
+        std::cout << "\n(checksum " << sink_ << ")" << std::endl;
+        return true;
+    }
+
+private:
+    static void appendFrame(std::vector<uint8_t>& out, uint8_t type, uint8_t flags, uint32_t stream_id,
+                            const std::vector<uint8_t>& payload) {
+        size_t length = payload.size();
+        uint8_t header[9] = {static_cast<uint8_t>(length >> 16), static_cast<uint8_t>(length >> 8),
+                             static_cast<uint8_t>(length), type, flags,
+                             static_cast<uint8_t>(stream_id >> 24), static_cast<uint8_t>(stream_id >> 16),
+                             static_cast<uint8_t>(stream_id >> 8), static_cast<uint8_t>(stream_id)};
+        out.insert(out.end(), header, header + 9);
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    // findHeader before the scanner: substring search, then a line-start check
+    static bool substringSearch(std::string_view block, std::string_view name, std::string_view& value) {
+        size_t pos = block.find(name);
+        if (pos == std::string_view::npos || (pos > 0 && block[pos - 1] != '\n')) return false;
+        value = block.substr(pos + name.size());
+        value = value.substr(0, value.find_first_of("\r\n"));
+        size_t first = value.find_first_not_of(' ');
+        if (first == std::string_view::npos) return false;
+        value = value.substr(first);
+        return true;
+    }
+
+    static size_t countSegments(const hello::FrameBatch& batch) {
+        size_t segments = 0;
+        for (size_t i = 0; i < batch.count; ++i) {
+            segments += batch.startsSegment(i);
+        }
+        return segments;
+    }
+
+    static bool sameBatch(const hello::FrameBatch& a, const hello::FrameBatch& b) {
+        if (a.count != b.count || a.offsets[a.count] != b.offsets[b.count]) return false;
+        for (size_t i = 0; i < a.count; ++i) {
+            if (a.offsets[i] != b.offsets[i] || a.types[i] != b.types[i] || a.flags[i] != b.flags[i] ||
+                a.stream_ids[i] != b.stream_ids[i] || a.startsSegment(i) != b.startsSegment(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename F>
+    static double timePerCall(int iterations, F&& call) {
+        for (int i = 0; i < iterations / 10 + 1; ++i) {
+            call();
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            call();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+
+    void printLookups(const char* label, double ns_per_pass) {
+        double lookups = header_blocks_.size() * 3.0;
+        std::cout << "  " << std::setw(7) << label << ": " << std::fixed << std::setprecision(2)
+                  << ns_per_pass / lookups << " ns/lookup" << std::endl;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        std::cout << "Usage: " << argv[0] << " [iterations]" << std::endl;
+        std::cout << "Example: " << argv[0] << " 100000" << std::endl;
+        return 1;
+    }
+
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 20000;
+    if (iterations <= 0) {
+        std::cerr << "Iterations must be positive" << std::endl;
+        return 1;
+    }
+
+    FrameScanBenchmark benchmark;
+    return benchmark.runTest(iterations) ? 0 : 1;
+}
@@ -204,11 +204,12 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "🚀 gRPC Server Latency Test" << std::endl;
     std::cout << "===========================" << std::endl;
     
-    const std::string serverAddress = "localhost:50051";
+    // Any gRPC target, e.g. unix:/tmp/grpcsvr.sock for a server started with --uds
+    const std::string serverAddress = argc > 1 ? argv[1] : "localhost:50051";
     
     try {
         LatencyTestClient client(serverAddress);
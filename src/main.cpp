@@ -2,6 +2,7 @@
 #include <iostream>
 #include <csignal>
 #include <atomic>
+#include <string>
 
 std::atomic<bool> running{true};
 
@@ -10,7 +11,68 @@ void signalHandler(int signal) {
     running = false;
 }
 
-int main() {
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--log-sample N] [--log-rate R] [--log-burst B]"
+              << " [--log-slow-us U] [--no-log-errors] [--arena]"
+              << " [--mode sync|async|callback] [--cqs N] [--stream-count N] [--stream-interval-ms M]"
+              << " [--uds PATH]" << std::endl;
+    std::cout << "  --log-sample N    log 1 in N calls (0 = none, default 1)" << std::endl;
+    std::cout << "  --log-rate R      at most R fully logged calls per second" << std::endl;
+    std::cout << "  --log-burst B     burst allowance for --log-rate (default 100)" << std::endl;
+    std::cout << "  --log-slow-us U   always log calls slower than U microseconds" << std::endl;
+    std::cout << "  --no-log-errors   do not force logging of failed calls" << std::endl;
+    std::cout << "  --arena           sync mode: serve SayHello on the callback API with pooled arenas" << std::endl;
+    std::cout << "  --mode M          sync (default), async (completion queue per core) or callback (reactors)" << std::endl;
+    std::cout << "  --cqs N           async mode: completion queues/threads (default: one per core)" << std::endl;
+    std::cout << "  --stream-count N  SayHelloStream messages per stream (default 5)" << std::endl;
+    std::cout << "  --stream-interval-ms M  pause between stream messages (default 100)" << std::endl;
+    std::cout << "  --uds PATH        also listen on unix:PATH for co-located clients" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    hello::LoggingPolicy loggingPolicy;
+    hello::ServerManager::Options options;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--log-sample" && i + 1 < argc) {
+            loggingPolicy.sample_one_in = std::stoul(argv[++i]);
+        } else if (arg == "--log-rate" && i + 1 < argc) {
+            loggingPolicy.max_logged_per_sec = std::stod(argv[++i]);
+        } else if (arg == "--log-burst" && i + 1 < argc) {
+            loggingPolicy.burst = std::stoul(argv[++i]);
+        } else if (arg == "--log-slow-us" && i + 1 < argc) {
+            loggingPolicy.slow_threshold_us = std::stoull(argv[++i]);
+        } else if (arg == "--no-log-errors") {
+            loggingPolicy.always_log_errors = false;
+        } else if (arg == "--arena") {
+            options.arena_messages = true;
+        } else if (arg == "--mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "sync") {
+                options.mode = hello::ServerMode::Sync;
+            } else if (mode == "async") {
+                options.mode = hello::ServerMode::Async;
+            } else if (mode == "callback") {
+                options.mode = hello::ServerMode::Callback;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--cqs" && i + 1 < argc) {
+            options.completion_queues = std::stoul(argv[++i]);
+        } else if (arg == "--stream-count" && i + 1 < argc) {
+            options.stream_pacing.count = std::stoi(argv[++i]);
+        } else if (arg == "--stream-interval-ms" && i + 1 < argc) {
+            options.stream_pacing.interval = std::chrono::milliseconds(std::stol(argv[++i]));
+        } else if (arg == "--uds" && i + 1 < argc) {
+            options.unix_socket_path = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
     // Set up signal handlers
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
@@ -20,10 +82,11 @@ int main() {
     
     // Get singleton instance and start server
     auto& serverManager = hello::ServerManager::getInstance();
+    serverManager.setLoggingPolicy(loggingPolicy);
     
     const std::string serverAddress = "0.0.0.0:50051";
     
-    if (!serverManager.startServer(serverAddress)) {
+    if (!serverManager.startServer(serverAddress, options)) {
         std::cerr << "Failed to start server" << std::endl;
         return 1;
     }
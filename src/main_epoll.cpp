@@ -1,15 +1,29 @@
 #include "EpollServer.h"
+#include "EpollHandlers.h"
+#include "EventTrace.h"
+#include "UdpFanout.h"
+#include "CoarseClock.h"
 #include <iostream>
+#include <string>
 #include <signal.h>
 #include <atomic>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 std::atomic<bool> running(true);
+std::atomic<bool> udp_publishing(false);
 
 void signalHandler(int signum) {
     std::cout << "\nReceived signal " << signum << ". Shutting down gracefully..." << std::endl;
     running = false;
 }
 
+// SIGUSR1 flips event tracing on and off without restarting the server
+void traceToggleHandler(int /*signum*/) {
+    hello::EventTracer::setEnabled(!hello::EventTracer::isEnabled());
+}
+
 void printStats(const hello::EpollServer::ServerStats& stats) {
     std::cout << "\n=== EpollServer Statistics ===" << std::endl;
     std::cout << "Total Connections: " << stats.total_connections.load() << std::endl;
@@ -18,10 +32,200 @@ void printStats(const hello::EpollServer::ServerStats& stats) {
     std::cout << "Total Bytes Sent: " << stats.total_bytes_sent.load() << " bytes" << std::endl;
     std::cout << "Total Bytes Received: " << stats.total_bytes_received.load() << " bytes" << std::endl;
     std::cout << "Epoll Events Processed: " << stats.epoll_events_processed.load() << std::endl;
+    std::cout << "Requests Shed (RESOURCE_EXHAUSTED): " << stats.requests_shed.load() << std::endl;
+    std::cout << "Requests Expired (DEADLINE_EXCEEDED): " << stats.requests_expired.load() << std::endl;
+    std::cout << "Late Responses Dropped: " << stats.late_responses_dropped.load() << std::endl;
+    std::cout << "Streams Reset (RST_STREAM): " << stats.streams_reset.load() << std::endl;
+    std::cout << "Unknown Methods (UNIMPLEMENTED): " << stats.requests_unimplemented.load() << std::endl;
+    std::cout << "Offloaded Requests: " << stats.offloaded_requests.load() << std::endl;
+    std::cout << "Coroutine Handlers Started: " << stats.coroutine_handlers.load()
+              << " (" << stats.coroutine_heap_frames.load() << " frames outside the pool)" << std::endl;
+    
+    uint64_t cache_hits = stats.response_cache_hits.load();
+    uint64_t cache_lookups = cache_hits + stats.response_cache_misses.load();
+    if (cache_lookups > 0) {
+        std::cout << "Response Cache Hit Rate: " << cache_hits * 100.0 / cache_lookups << "% ("
+                  << cache_hits << "/" << cache_lookups << ")" << std::endl;
+    }
+    
+    uint64_t requests = stats.total_requests.load();
+    uint64_t cycles = stats.cpu_cycles.load();
+    if (cycles > 0) {
+        std::cout << "Worker IPC: " << static_cast<double>(stats.instructions.load()) / cycles << std::endl;
+        if (requests > 0) {
+            std::cout << "Per Request: " << cycles / requests << " cycles, "
+                      << stats.instructions.load() / requests << " instructions, "
+                      << static_cast<double>(stats.cache_misses.load()) / requests << " cache misses, "
+                      << static_cast<double>(stats.branch_misses.load()) / requests << " branch misses" << std::endl;
+        }
+    }
+    std::cout << "Worker Context Switches: " << stats.context_switches.load() << std::endl;
     std::cout << "=================================" << std::endl;
 }
 
-int main() {
+// Upper bound of the bucket holding the given percentile
+uint64_t bucketPercentile(const std::vector<uint64_t>& buckets, uint64_t total, double percentile) {
+    uint64_t target = static_cast<uint64_t>(total * percentile / 100.0);
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        cumulative += buckets[b];
+        if (cumulative > target) {
+            return hello::latencyBucketUpperBound(static_cast<int>(b));
+        }
+    }
+    return hello::latencyBucketUpperBound(static_cast<int>(buckets.size()) - 1);
+}
+
+// Arrival-to-queued latency per priority lane, summed over the workers
+void printLaneStats(const hello::EpollServer& server) {
+    for (int lane = 0; lane < hello::NUM_TRAFFIC_CLASSES; ++lane) {
+        std::vector<uint64_t> buckets(hello::StatsSegmentLayout::LATENCY_BUCKETS, 0);
+        uint64_t total = 0;
+        for (int w = 0; w < server.getWorkerCount(); ++w) {
+            const auto& worker = server.getWorkerStats(w);
+            for (size_t b = 0; b < buckets.size(); ++b) {
+                uint64_t count = worker.class_latency_buckets[lane][b].load();
+                buckets[b] += count;
+                total += count;
+            }
+        }
+        if (total == 0) continue;
+        std::cout << "Lane " << hello::trafficClassName(static_cast<hello::TrafficClass>(lane)) << ": "
+                  << total << " requests, p50 < " << bucketPercentile(buckets, total, 50.0) / 1000.0
+                  << " us, p99 < " << bucketPercentile(buckets, total, 99.0) / 1000.0 << " us" << std::endl;
+    }
+}
+
+// Handler executor activity, when any method is offloaded
+void printExecutorStats(const hello::EpollServer& server) {
+    if (server.getExecutorThreads() == 0) return;
+    hello::WorkStealingExecutor::Stats executor = server.getExecutorStats();
+    std::cout << "Executor: " << server.getExecutorThreads() << " threads, " << executor.executed
+              << " handlers run, " << executor.steals << " stolen, queue depth " << executor.queue_depth << std::endl;
+}
+
+// Market-data style ticker: every interval, a batch of SayHello greetings
+// goes to every UDP subscriber in one flush
+void runUdpPublisher(hello::UdpPublisher& publisher, int batch, int interval_us) {
+    uint64_t tick = 0;
+    while (udp_publishing.load()) {
+        uint64_t now_us = hello::CoarseClock::preciseMicros();
+        for (int i = 0; i < batch; ++i) {
+            publisher.publish("Subscriber", static_cast<int32_t>(tick++ % 100), now_us);
+        }
+        publisher.flush();
+        std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+    }
+}
+
+void printUdpStats(const hello::UdpPublisher& publisher) {
+    const auto& stats = publisher.stats();
+    std::cout << "UDP Updates Published: " << stats.updates << " (" << stats.datagrams << " datagrams, "
+              << stats.send_calls << " sendmmsg calls, " << stats.send_errors << " refused"
+              << (publisher.gsoActive() ? ", GSO" : "") << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string trace_path;
+    bool trace_enabled = true;
+    bool perf_counters = true;
+    std::string unix_socket_path;
+    std::string shm_socket_path;
+    std::string handoff_path;
+    bool takeover = false;
+    bool takeover_connections = false;
+    int drain_timeout_s = 30;
+    hello::AdmissionController::Options admission;
+    hello::EpollServer::PriorityLaneOptions lanes;
+    bool critical_workers_set = false;
+    hello::EpollServer::OffloadOptions offload;
+    bool executor_threads_set = false;
+    bool coroutine_stream = true;
+    hello::UdpPublisher::Options udp;
+    int udp_interval_us = 1000;
+    int udp_batch = 16;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (arg == "--trace-paused") {
+            trace_enabled = false;
+        } else if (arg == "--no-perf-counters") {
+            perf_counters = false;
+        } else if (arg == "--uds" && i + 1 < argc) {
+            unix_socket_path = argv[++i];
+        } else if (arg == "--shm" && i + 1 < argc) {
+            shm_socket_path = argv[++i];
+        } else if (arg == "--handoff" && i + 1 < argc) {
+            handoff_path = argv[++i];
+        } else if (arg == "--takeover") {
+            takeover = true;
+        } else if (arg == "--takeover-connections") {
+            takeover = true;
+            takeover_connections = true;
+        } else if (arg == "--drain-timeout" && i + 1 < argc) {
+            drain_timeout_s = std::stoi(argv[++i]);
+        } else if (arg == "--shed-target-ms" && i + 1 < argc) {
+            admission.target_us = std::stoull(argv[++i]) * 1000;
+        } else if (arg == "--shed-interval-ms" && i + 1 < argc) {
+            admission.interval_us = std::stoull(argv[++i]) * 1000;
+        } else if (arg == "--no-shedding") {
+            admission.enabled = false;
+        } else if (arg == "--critical-port" && i + 1 < argc) {
+            lanes.critical_port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--critical-workers" && i + 1 < argc) {
+            lanes.critical_workers = std::stoi(argv[++i]);
+            critical_workers_set = true;
+        } else if (arg == "--offload" && i + 1 < argc) {
+            offload.methods.push_back(argv[++i]);
+        } else if (arg == "--executor-threads" && i + 1 < argc) {
+            offload.threads = std::stoi(argv[++i]);
+            executor_threads_set = true;
+        } else if (arg == "--no-coroutine-stream") {
+            coroutine_stream = false;
+        } else if (arg == "--udp-publish" && i + 1 < argc) {
+            udp.destinations.push_back(argv[++i]);
+        } else if (arg == "--udp-gso") {
+            udp.gso = true;
+        } else if (arg == "--udp-interval-us" && i + 1 < argc) {
+            udp_interval_us = std::stoi(argv[++i]);
+        } else if (arg == "--udp-batch" && i + 1 < argc) {
+            udp_batch = std::stoi(argv[++i]);
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--trace <file>] [--trace-paused] [--no-perf-counters] [--uds <path>]"
+                      << " [--shm <path>] [--handoff <path> [--takeover] [--takeover-connections]]"
+                      << " [--drain-timeout <s>] [--shed-target-ms <ms>] [--shed-interval-ms <ms>] [--no-shedding]"
+                      << " [--critical-port <port>] [--critical-workers <n>]"
+                      << " [--offload <method>]... [--executor-threads <n>] [--no-coroutine-stream]"
+                      << " [--udp-publish <ip:port>]... [--udp-gso] [--udp-interval-us <us>] [--udp-batch <n>]" << std::endl;
+            std::cout << "  --trace <file>   record per-worker binary events (decode with gRpcSvr_trace_decode)" << std::endl;
+            std::cout << "  --trace-paused   start with recording off; send SIGUSR1 to toggle" << std::endl;
+            std::cout << "  --no-perf-counters  skip per-worker hardware counters (cycles, IPC, misses)" << std::endl;
+            std::cout << "  --uds <path>     also accept clients on a Unix domain socket at path" << std::endl;
+            std::cout << "  --shm <path>     serve shared-memory ring clients; path is the handshake socket" << std::endl;
+            std::cout << "  --handoff <path> hand listeners to a successor that connects on path (hot restart)" << std::endl;
+            std::cout << "  --takeover       take listeners over from the server on the --handoff path" << std::endl;
+            std::cout << "  --takeover-connections  also take over its open TCP/UDS connections" << std::endl;
+            std::cout << "  --drain-timeout <s>  after handing off, wait this long for connections to close (default 30)" << std::endl;
+            std::cout << "  --shed-target-ms <ms>    queue delay a worker may sustain before shedding (default 5)" << std::endl;
+            std::cout << "  --shed-interval-ms <ms>  window the minimum queue delay is taken over (default 100)" << std::endl;
+            std::cout << "  --no-shedding    serve every request however long it queued" << std::endl;
+            std::cout << "  --critical-port <port>   priority-lane listener; \"x-priority: critical\" also selects the lane" << std::endl;
+            std::cout << "  --critical-workers <n>   workers (and cores) reserved for the critical lane (default 2 with a port)" << std::endl;
+            std::cout << "  --offload <method>       run this method's handler on the work-stealing executor, e.g." << std::endl;
+            std::cout << "                           /hello.HelloService/SayHello (repeatable; others stay inline)" << std::endl;
+            std::cout << "  --executor-threads <n>   executor threads for offloaded handlers (default 2 with --offload)" << std::endl;
+            std::cout << "  --no-coroutine-stream    answer SayHelloStream like SayHello instead of with the paced coroutine handler" << std::endl;
+            std::cout << "  --udp-publish <ip:port>  fan HelloResponse updates out over UDP to this subscriber or multicast" << std::endl;
+            std::cout << "                           group (repeatable; receive with gRpcSvr_udp_subscriber)" << std::endl;
+            std::cout << "  --udp-gso                send each batch as one UDP_SEGMENT super-datagram per destination" << std::endl;
+            std::cout << "  --udp-interval-us <us>   time between update batches (default 1000)" << std::endl;
+            std::cout << "  --udp-batch <n>          updates per batch (default 16, at most 64)" << std::endl;
+            return 1;
+        }
+    }
+    
     std::cout << "🚀 Starting Epoll-Optimized gRPC Server" << std::endl;
     std::cout << "=====================================" << std::endl;
     std::cout << "Features:" << std::endl;
@@ -37,8 +241,40 @@ int main() {
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
     
+    // Start the trace drain thread before workers register their rings
+    if (!trace_path.empty()) {
+        if (!hello::EventTracer::getInstance().start(trace_path)) {
+            return 1;
+        }
+        hello::EventTracer::setEnabled(trace_enabled);
+        signal(SIGUSR1, traceToggleHandler);
+        std::cout << "Event tracing to " << trace_path << (trace_enabled ? " (recording)" : " (paused)")
+                  << ", toggle with: kill -USR1 " << getpid() << std::endl;
+    }
+    
     // Get server instance
     auto& server = hello::EpollServer::getInstance();
+    server.setPerfCountersEnabled(perf_counters);
+    server.setAdmissionControl(admission);
+    if (lanes.critical_port != 0 && !critical_workers_set) {
+        lanes.critical_workers = 2;
+    }
+    server.setPriorityLanes(lanes);
+    if (!offload.methods.empty() && !executor_threads_set) {
+        offload.threads = 2;
+    }
+    server.setOffload(offload);
+    if (coroutine_stream) {
+        server.registerHandler("/hello.HelloService/SayHelloStream", hello::sayHelloStream);
+    }
+    server.setUnixSocketPath(unix_socket_path);
+    server.setShmSocketPath(shm_socket_path);
+    if (takeover && handoff_path.empty()) {
+        std::cerr << "--takeover needs --handoff <path>" << std::endl;
+        return 1;
+    }
+    server.setHandoffPath(handoff_path);
+    server.setTakeover(takeover, takeover_connections);
     
     // Start server
     const std::string address = "0.0.0.0";
@@ -51,26 +287,67 @@ int main() {
     
     std::cout << "EpollServer is running. Press Ctrl+C to stop." << std::endl;
     
+    // UDP fan-out runs next to the TCP server on a thread of its own
+    hello::UdpPublisher publisher;
+    std::thread udp_thread;
+    if (!udp.destinations.empty()) {
+        udp_batch = std::max(1, std::min(udp_batch, hello::UdpPublisher::MAX_BATCH));
+        if (publisher.open(udp)) {
+            std::cout << "Publishing " << udp_batch << " update(s) every " << udp_interval_us << "μs to "
+                      << udp.destinations.size() << " UDP destination(s)"
+                      << (publisher.gsoActive() ? " with GSO" : "") << std::endl;
+            udp_publishing.store(true);
+            udp_thread = std::thread(runUdpPublisher, std::ref(publisher), udp_batch, udp_interval_us);
+        }
+    }
+    
     // Main loop with periodic stats
     auto last_stats_time = std::chrono::steady_clock::now();
     
-    while (running.load()) {
-        std::this_thread::sleep_for(std::chrono::seconds(10));
+    // Short sleeps so a handoff to a successor is noticed promptly
+    while (running.load() && !server.handedOff()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
         // Print stats every 30 seconds
         auto now = std::chrono::steady_clock::now();
         if (now - last_stats_time > std::chrono::seconds(30)) {
             printStats(server.getStats());
+            printLaneStats(server);
+            printExecutorStats(server);
             last_stats_time = now;
         }
     }
     
+    if (udp_thread.joinable()) {
+        udp_publishing.store(false);
+        udp_thread.join();
+        publisher.close();
+    }
+    
+    // A successor owns the listeners now; finish what is still open here
+    if (server.handedOff()) {
+        std::cout << "Handed off to successor, draining (up to " << drain_timeout_s << "s)..." << std::endl;
+        server.drain(std::chrono::seconds(drain_timeout_s));
+    }
+    
     // Stop server
     server.stopServer();
     
+    if (!trace_path.empty()) {
+        auto& tracer = hello::EventTracer::getInstance();
+        tracer.stop();
+        std::cout << "Trace records written: " << tracer.recordsWritten()
+                  << ", dropped: " << tracer.recordsDropped() << std::endl;
+    }
+    
     // Final stats
     std::cout << "\n=== Final Statistics ===" << std::endl;
     printStats(server.getStats());
+    printLaneStats(server);
+    printExecutorStats(server);
+    if (!udp.destinations.empty()) {
+        printUdpStats(publisher);
+    }
     
     std::cout << "EpollServer shutdown complete." << std::endl;
     return 0;
@@ -213,14 +213,20 @@ void printStreamingTestResult(const PerformanceTestClient::StreamingTestResult&
 }
 
 void saveResultsToFile(const std::vector<PerformanceTestClient::UnaryTestResult>& unary_results,
-                      const std::vector<PerformanceTestClient::StreamingTestResult>& streaming_results) {
-    std::ofstream file("performance_report.txt");
+                      const std::vector<PerformanceTestClient::StreamingTestResult>& streaming_results,
+                      const std::string& label) {
+    // One report per label, so runs against differently configured servers can be compared
+    std::string filename = label.empty() ? "performance_report.txt" : "performance_report_" + label + ".txt";
+    std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Failed to open performance_report.txt for writing" << std::endl;
+        std::cerr << "Failed to open " << filename << " for writing" << std::endl;
         return;
     }
 
     file << "gRPC SERVER PERFORMANCE TEST REPORT" << std::endl;
+    if (!label.empty()) {
+        file << "Server: " << label << std::endl;
+    }
     file << "Generated: " << std::chrono::system_clock::now().time_since_epoch().count() << std::endl;
     file << std::string(80, '=') << std::endl << std::endl;
 
@@ -256,14 +262,20 @@ void saveResultsToFile(const std::vector<PerformanceTestClient::UnaryTestResult>
     }
 
     file.close();
-    std::cout << "\nPerformance report saved to: performance_report.txt" << std::endl;
+    std::cout << "\nPerformance report saved to: " << filename << std::endl;
 }
 
-int main() {
-    std::string serverAddress = "localhost:50051";
+int main(int argc, char* argv[]) {
+    // Usage: gRpcSvr_perf_test [address] [label], e.g. label "sync" or "async"
+    // after starting gRpcSvr_optimized with the matching --mode
+    std::string serverAddress = argc > 1 ? argv[1] : "localhost:50051";
+    std::string label = argc > 2 ? argv[2] : "";
     
     std::cout << "gRPC Performance Test Client" << std::endl;
     std::cout << "Connecting to server at: " << serverAddress << std::endl;
+    if (!label.empty()) {
+        std::cout << "Server label: " << label << std::endl;
+    }
     std::cout << "Make sure the server is running before starting tests!" << std::endl;
     std::cout << std::string(60, '=') << std::endl;
     
@@ -304,7 +316,7 @@ int main() {
     streaming_results.push_back(result5);
 
     // Save results to file
-    saveResultsToFile(unary_results, streaming_results);
+    saveResultsToFile(unary_results, streaming_results, label);
 
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "PERFORMANCE TESTING COMPLETED" << std::endl;
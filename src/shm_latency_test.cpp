@@ -0,0 +1,167 @@
+#include "ShmClient.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <sched.h>
+#include <pthread.h>
+
+// Round-trip latency over the shared-memory transport (gRpcSvr_epoll --shm <path>)
+class ShmLatencyTest {
+private:
+    static constexpr int WARMUP_REQUESTS = 10000;
+    static constexpr int LATENCY_SAMPLES = 200000;
+    static constexpr int PIPELINE_DEPTH = 32;
+    static constexpr int THROUGHPUT_SECONDS = 3;
+
+    hello::ShmHelloClient client_;
+    hello::HelloRequest request_;
+    hello::HelloResponse response_;
+
+public:
+    ShmLatencyTest() {
+        request_.set_name("ShmClient");
+        request_.set_age(25);
+    }
+
+    bool runTest(const std::string& socket_path, hello::ShmWaitMode mode, int cpu_core) {
+        std::cout << "=== Shared-Memory Transport Latency Test ===" << std::endl;
+        std::cout << "Control socket: " << socket_path << std::endl;
+        std::cout << "Wait mode: " << (mode == hello::ShmWaitMode::BusyPoll ? "busy-poll" : "futex") << std::endl;
+        std::cout << "Samples: " << LATENCY_SAMPLES << std::endl;
+        std::cout << "==========================================" << std::endl;
+
+        if (cpu_core >= 0) {
+            setCpuAffinity(cpu_core);
+        }
+
+        if (!client_.connect(socket_path, mode)) {
+            return false;
+        }
+
+        std::cout << "\nWarming up..." << std::endl;
+        for (int i = 0; i < WARMUP_REQUESTS; ++i) {
+            if (!client_.sayHello(request_, &response_)) {
+                std::cerr << "Warmup request " << i << " failed" << std::endl;
+                return false;
+            }
+        }
+        std::cout << "Sample response: " << response_.message() << std::endl;
+
+        std::cout << "\nRound-Trip Latency Test:" << std::endl;
+        testRoundTripLatency();
+
+        std::cout << "\nPipelined Throughput Test (" << PIPELINE_DEPTH << " in flight):" << std::endl;
+        testPipelinedThroughput();
+
+        client_.close();
+        return true;
+    }
+
+private:
+    void testRoundTripLatency() {
+        std::vector<uint64_t> latencies;
+        latencies.reserve(LATENCY_SAMPLES);
+        uint64_t failed = 0;
+
+        for (int i = 0; i < LATENCY_SAMPLES; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            bool success = client_.sayHello(request_, &response_);
+            auto end = std::chrono::steady_clock::now();
+
+            if (success) {
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            } else {
+                ++failed;
+            }
+        }
+
+        if (latencies.empty()) {
+            std::cout << "  All " << failed << " requests failed" << std::endl;
+            return;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        uint64_t min_latency = latencies.front();
+        uint64_t max_latency = latencies.back();
+        uint64_t avg_latency = std::accumulate(latencies.begin(), latencies.end(), 0ULL) / latencies.size();
+        uint64_t p50_latency = latencies[latencies.size() * 50 / 100];
+        uint64_t p90_latency = latencies[latencies.size() * 90 / 100];
+        uint64_t p99_latency = latencies[latencies.size() * 99 / 100];
+        uint64_t p999_latency = latencies[latencies.size() * 999 / 1000];
+        uint64_t p9999_latency = latencies[latencies.size() * 9999 / 10000];
+        uint64_t sub_microsecond = std::count_if(latencies.begin(), latencies.end(),
+                                                 [](uint64_t l) { return l < 1000; });
+
+        std::cout << "  Min latency: " << min_latency << " ns (" << min_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  Max latency: " << max_latency << " ns (" << max_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  Avg latency: " << avg_latency << " ns (" << avg_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  P50 latency: " << p50_latency << " ns (" << p50_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  P90 latency: " << p90_latency << " ns (" << p90_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  P99 latency: " << p99_latency << " ns (" << p99_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  P99.9 latency: " << p999_latency << " ns (" << p999_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  P99.99 latency: " << p9999_latency << " ns (" << p9999_latency / 1000.0 << " μs)" << std::endl;
+        std::cout << "  Sub-microsecond requests: " << sub_microsecond << " ("
+                  << (sub_microsecond * 100.0 / latencies.size()) << "%)" << std::endl;
+        std::cout << "  Failed: " << failed << std::endl;
+    }
+
+    void testPipelinedThroughput() {
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::seconds(THROUGHPUT_SECONDS);
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            while (sent - received < PIPELINE_DEPTH && client_.send(request_)) {
+                ++sent;
+            }
+            if (!client_.receive(&response_)) {
+                break;
+            }
+            ++received;
+        }
+        while (received < sent && client_.receive(&response_)) {
+            ++received;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  Requests sent: " << sent << std::endl;
+        std::cout << "  Responses received: " << received << std::endl;
+        std::cout << "  Throughput: " << static_cast<uint64_t>(received / seconds) << " RPS" << std::endl;
+    }
+
+    void setCpuAffinity(int cpu_core) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu_core, &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cout << "Usage: " << argv[0] << " <control_socket> [busy|futex] [cpu_core]" << std::endl;
+        std::cout << "Example: " << argv[0] << " /tmp/gRpcSvr_shm.sock busy 2" << std::endl;
+        return 1;
+    }
+
+    std::string socket_path = argv[1];
+    hello::ShmWaitMode mode = hello::ShmWaitMode::BusyPoll;
+    if (argc > 2) {
+        std::string mode_name = argv[2];
+        if (mode_name == "futex") {
+            mode = hello::ShmWaitMode::Futex;
+        } else if (mode_name != "busy") {
+            std::cerr << "Unknown wait mode: " << mode_name << std::endl;
+            return 1;
+        }
+    }
+    int cpu_core = argc > 3 ? std::stoi(argv[3]) : -1;
+
+    ShmLatencyTest test;
+    return test.runTest(socket_path, mode, cpu_core) ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+#include "StatsSegment.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+
+// Live, read-only viewer for the EpollServer shared-memory statistics segment
+namespace {
+
+std::atomic<bool> running{true};
+
+void signalHandler(int /*signum*/) {
+    running = false;
+}
+
+// Sections hold the seqlock atomic, so snapshots own them through pointers to stay movable
+struct Snapshot {
+    std::unique_ptr<hello::StatsSegmentLayout::GlobalSection> global;
+    std::unique_ptr<hello::StatsSegmentLayout::WorkerSection[]> workers;
+    std::unique_ptr<hello::StatsSegmentLayout::ClassSection[]> classes;
+    uint32_t num_workers = 0;
+    uint32_t num_classes = 0;
+};
+
+bool takeSnapshot(const hello::StatsSegment& segment, Snapshot& snapshot) {
+    snapshot.num_workers = segment.header().num_workers;
+    snapshot.global = std::make_unique<hello::StatsSegmentLayout::GlobalSection>();
+    snapshot.workers = std::make_unique<hello::StatsSegmentLayout::WorkerSection[]>(snapshot.num_workers);
+    snapshot.num_classes = segment.header().num_classes;
+    snapshot.classes = std::make_unique<hello::StatsSegmentLayout::ClassSection[]>(snapshot.num_classes);
+
+    if (!segment.readGlobal(*snapshot.global)) return false;
+    for (uint32_t i = 0; i < snapshot.num_workers; ++i) {
+        if (!segment.readWorker(i, snapshot.workers[i])) return false;
+    }
+    for (uint32_t i = 0; i < snapshot.num_classes; ++i) {
+        if (!segment.readClass(i, snapshot.classes[i])) return false;
+    }
+    return true;
+}
+
+// Percentile of a log2 histogram, reported as the upper bound of the matching bucket
+uint64_t histogramPercentile(const std::vector<uint64_t>& buckets, double percentile) {
+    uint64_t total = 0;
+    for (uint64_t count : buckets) total += count;
+    if (total == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(total * percentile / 100.0);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative > target) {
+            return hello::latencyBucketUpperBound(static_cast<int>(i));
+        }
+    }
+    return hello::latencyBucketUpperBound(static_cast<int>(buckets.size()) - 1);
+}
+
+std::string formatLatency(uint64_t ns) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (ns == 0) {
+        oss << "-";
+    } else if (ns < 1000) {
+        oss << "<" << ns << "ns";
+    } else if (ns < 1000000) {
+        oss << "<" << ns / 1000.0 << "us";
+    } else {
+        oss << "<" << ns / 1000000.0 << "ms";
+    }
+    return oss.str();
+}
+
+double perSecond(uint64_t now, uint64_t before, double seconds) {
+    return (seconds > 0 && now >= before) ? (now - before) / seconds : 0.0;
+}
+
+uint64_t delta(uint64_t now, uint64_t before) {
+    return now >= before ? now - before : 0;
+}
+
+double ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator > 0 ? static_cast<double>(numerator) / denominator : 0.0;
+}
+
+void render(const hello::StatsSegment& segment, const std::string& name,
+            const Snapshot& now, const Snapshot& before, bool clear_screen) {
+    const auto& header = segment.header();
+    double seconds = (now.global->publish_time_ns - before.global->publish_time_ns) / 1e9;
+    uint64_t local_now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    bool stale = local_now_ns > now.global->publish_time_ns + 5 * header.publish_interval_ms * 1000000ULL;
+
+    std::vector<uint64_t> interval_buckets(hello::StatsSegmentLayout::LATENCY_BUCKETS, 0);
+    for (size_t w = 0; w < now.num_workers; ++w) {
+        for (int b = 0; b < hello::StatsSegmentLayout::LATENCY_BUCKETS; ++b) {
+            uint64_t cur = now.workers[w].latency_buckets[b];
+            uint64_t prev = before.workers[w].latency_buckets[b];
+            interval_buckets[b] += cur >= prev ? cur - prev : 0;
+        }
+    }
+
+    if (clear_screen) {
+        std::cout << "\033[H\033[2J";
+    }
+
+    std::cout << "gRpcSvr_top - " << name << "  pid " << header.pid << "  port " << header.port
+              << (stale ? "  [STALE: server not publishing]" : "") << std::endl;
+    std::cout << std::string(78, '=') << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Connections: " << now.global->active_connections << " active, "
+              << now.global->total_connections << " total ("
+              << perSecond(now.global->total_connections, before.global->total_connections, seconds) << "/s)" << std::endl;
+    std::cout << "Requests:    " << now.global->total_requests << " total, "
+              << perSecond(now.global->total_requests, before.global->total_requests, seconds) << " RPS" << std::endl;
+    uint64_t interval_shed = delta(now.global->requests_shed, before.global->requests_shed);
+    uint64_t interval_offered = interval_shed + delta(now.global->total_requests, before.global->total_requests);
+    std::cout << "Shed:        " << now.global->requests_shed << " total, " << perSecond(interval_shed, 0, seconds)
+              << "/s (" << ratio(interval_shed * 100, interval_offered) << "% of offered)" << std::endl;
+    std::cout << "Expired:     " << perSecond(now.global->requests_expired, before.global->requests_expired, seconds)
+              << " req/s skipped, " << perSecond(now.global->late_responses_dropped, before.global->late_responses_dropped, seconds)
+              << " late resp/s dropped, " << perSecond(now.global->streams_reset, before.global->streams_reset, seconds)
+              << " RST_STREAM/s" << std::endl;
+    if (now.global->executor_threads > 0) {
+        std::cout << "Executor:    " << now.global->executor_threads << " threads, "
+                  << perSecond(now.global->offloaded_requests, before.global->offloaded_requests, seconds)
+                  << " offloaded/s, " << perSecond(now.global->executor_steals, before.global->executor_steals, seconds)
+                  << " steals/s, queue depth " << now.global->executor_queue_depth << std::endl;
+    }
+    std::cout << "Traffic:     RX " << perSecond(now.global->total_bytes_received, before.global->total_bytes_received, seconds) / 1e6
+              << " MB/s, TX " << perSecond(now.global->total_bytes_sent, before.global->total_bytes_sent, seconds) / 1e6
+              << " MB/s, events " << perSecond(now.global->epoll_events_processed, before.global->epoll_events_processed, seconds)
+              << "/s" << std::endl;
+    std::cout << "Latency:     p50 " << formatLatency(histogramPercentile(interval_buckets, 50.0))
+              << "  p90 " << formatLatency(histogramPercentile(interval_buckets, 90.0))
+              << "  p99 " << formatLatency(histogramPercentile(interval_buckets, 99.0))
+              << "  p99.9 " << formatLatency(histogramPercentile(interval_buckets, 99.9))
+              << "  max " << formatLatency(now.global->max_latency_ns) << std::endl;
+
+    // Per priority lane, measured from request arrival to response queued
+    for (size_t c = 0; c < now.num_classes; ++c) {
+        const auto& cur = now.classes[c];
+        const auto& prev = before.classes[c];
+        std::vector<uint64_t> buckets(hello::StatsSegmentLayout::LATENCY_BUCKETS, 0);
+        for (int b = 0; b < hello::StatsSegmentLayout::LATENCY_BUCKETS; ++b) {
+            buckets[b] = delta(cur.latency_buckets[b], prev.latency_buckets[b]);
+        }
+        std::string label = std::string(cur.name, strnlen(cur.name, sizeof(cur.name))) + ":";
+        std::cout << "  " << std::left << std::setw(11) << label << std::right
+                  << perSecond(cur.requests, prev.requests, seconds) << " RPS"
+                  << "  p50 " << formatLatency(histogramPercentile(buckets, 50.0))
+                  << "  p99 " << formatLatency(histogramPercentile(buckets, 99.0))
+                  << "  p99.9 " << formatLatency(histogramPercentile(buckets, 99.9)) << std::endl;
+    }
+
+    uint64_t interval_requests = delta(now.global->total_requests, before.global->total_requests);
+    uint64_t interval_cycles = delta(now.global->cpu_cycles, before.global->cpu_cycles);
+
+    uint64_t cache_hits = delta(now.global->response_cache_hits, before.global->response_cache_hits);
+    uint64_t cache_lookups = cache_hits + delta(now.global->response_cache_misses, before.global->response_cache_misses);
+    std::cout << "Resp cache:  hit " << ratio(cache_hits * 100, cache_lookups) << "% of "
+              << perSecond(cache_lookups, 0, seconds) << " lookups/s" << std::endl;
+
+    if (now.global->cpu_cycles > 0) {
+        std::cout << "CPU:         IPC " << std::setprecision(2)
+                  << ratio(delta(now.global->instructions, before.global->instructions), interval_cycles)
+                  << std::setprecision(1)
+                  << "  cycles/req " << ratio(interval_cycles, interval_requests)
+                  << "  cache-miss/req " << ratio(delta(now.global->cache_misses, before.global->cache_misses), interval_requests)
+                  << "  br-miss/req " << ratio(delta(now.global->branch_misses, before.global->branch_misses), interval_requests)
+                  << "  ctx-sw/s " << perSecond(now.global->context_switches, before.global->context_switches, seconds)
+                  << std::endl;
+    } else {
+        std::cout << "CPU:         hardware counters unavailable  ctx-sw/s "
+                  << perSecond(now.global->context_switches, before.global->context_switches, seconds) << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(8) << "WORKER" << std::setw(6) << "CORE"
+              << std::right << std::setw(12) << "REQ/s" << std::setw(12) << "EVENTS/s"
+              << std::setw(8) << "BUSY%" << std::setw(8) << "SHARE%"
+              << std::setw(11) << "p50" << std::setw(11) << "p99"
+              << std::setw(7) << "IPC" << std::setw(11) << "CYC/REQ" << std::setw(10) << "MISS/REQ"
+              << std::setw(10) << "SHED/s" << std::endl;
+
+    for (size_t w = 0; w < now.num_workers; ++w) {
+        const auto& cur = now.workers[w];
+        const auto& prev = before.workers[w];
+
+        std::vector<uint64_t> buckets(hello::StatsSegmentLayout::LATENCY_BUCKETS, 0);
+        for (int b = 0; b < hello::StatsSegmentLayout::LATENCY_BUCKETS; ++b) {
+            buckets[b] = cur.latency_buckets[b] >= prev.latency_buckets[b]
+                ? cur.latency_buckets[b] - prev.latency_buckets[b] : 0;
+        }
+
+        uint64_t worker_requests = cur.requests >= prev.requests ? cur.requests - prev.requests : 0;
+        double busy = seconds > 0 ? perSecond(cur.busy_ns, prev.busy_ns, seconds) / 1e9 * 100.0 : 0.0;
+        double share = interval_requests > 0 ? worker_requests * 100.0 / interval_requests : 0.0;
+
+        std::cout << std::left << std::setw(8) << w << std::setw(6) << cur.cpu_core
+                  << std::right << std::setw(12) << perSecond(cur.requests, prev.requests, seconds)
+                  << std::setw(12) << perSecond(cur.events, prev.events, seconds)
+                  << std::setw(8) << busy << std::setw(8) << share
+                  << std::setw(11) << formatLatency(histogramPercentile(buckets, 50.0))
+                  << std::setw(11) << formatLatency(histogramPercentile(buckets, 99.0))
+                  << std::setprecision(2) << std::setw(7) << ratio(delta(cur.instructions, prev.instructions), delta(cur.cycles, prev.cycles))
+                  << std::setprecision(0) << std::setw(11) << ratio(delta(cur.cycles, prev.cycles), worker_requests)
+                  << std::setprecision(1) << std::setw(10) << ratio(delta(cur.cache_misses, prev.cache_misses), worker_requests)
+                  << std::setw(10) << perSecond(cur.requests_shed, prev.requests_shed, seconds)
+                  << (cur.overloaded ? "  overloaded" : "") << std::endl;
+    }
+    std::cout << std::flush;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name = hello::StatsSegment::defaultName(50052);
+    int interval_ms = 1000;
+    bool once = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--once") {
+            once = true;
+        } else if (arg == "--interval" && i + 1 < argc) {
+            interval_ms = std::max(100, std::stoi(argv[++i]));
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [port|/segment_name] [--interval ms] [--once]" << std::endl;
+            std::cout << "Example: " << argv[0] << " 50052 --interval 500" << std::endl;
+            return 0;
+        } else if (!arg.empty() && arg[0] == '/') {
+            name = arg;
+        } else {
+            name = hello::StatsSegment::defaultName(static_cast<uint16_t>(std::stoi(arg)));
+        }
+    }
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    hello::StatsSegment segment;
+    if (!segment.attach(name)) {
+        std::cerr << "Is gRpcSvr_epoll running on this host?" << std::endl;
+        return 1;
+    }
+
+    Snapshot before;
+    if (!takeSnapshot(segment, before)) {
+        std::cerr << "Stats segment is busy, try again" << std::endl;
+        return 1;
+    }
+
+    while (running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+        Snapshot now;
+        if (!takeSnapshot(segment, now)) {
+            continue;
+        }
+
+        render(segment, name, now, before, !once);
+        before = std::move(now);
+
+        if (once) break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "EventTrace.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+// Decoder for EpollServer binary event traces: prints a per-event timeline and
+// a summary of the time spent between consecutive events on the same connection
+namespace {
+
+struct Options {
+    std::string path;
+    int fd = -1;
+    int worker = -1;
+    size_t limit = 0;
+    bool summary_only = false;
+};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <trace_file> [--fd N] [--worker N] [--limit N] [--summary]" << std::endl;
+    std::cout << "Example: " << program << " epoll.trace --fd 12" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fd" && i + 1 < argc) {
+            options.fd = std::stoi(argv[++i]);
+        } else if (arg == "--worker" && i + 1 < argc) {
+            options.worker = std::stoi(argv[++i]);
+        } else if (arg == "--limit" && i + 1 < argc) {
+            options.limit = std::stoul(argv[++i]);
+        } else if (arg == "--summary") {
+            options.summary_only = true;
+        } else if (options.path.empty() && arg[0] != '-') {
+            options.path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.path.empty();
+}
+
+double ticksToMicros(uint64_t ticks, uint64_t tsc_hz) {
+    return tsc_hz > 0 ? ticks * 1e6 / static_cast<double>(tsc_hz) : 0.0;
+}
+
+void printSummary(const std::vector<hello::TraceRecord>& records, uint64_t tsc_hz) {
+    std::map<uint8_t, uint64_t> event_counts;
+    std::map<std::pair<uint8_t, uint8_t>, std::vector<uint64_t>> transitions;
+    std::unordered_map<int32_t, const hello::TraceRecord*> last_on_fd;
+
+    for (const auto& record : records) {
+        event_counts[record.event]++;
+
+        auto it = last_on_fd.find(record.fd);
+        if (it != last_on_fd.end() && record.tsc >= it->second->tsc) {
+            transitions[{it->second->event, record.event}].push_back(record.tsc - it->second->tsc);
+        }
+
+        if (record.event == static_cast<uint8_t>(hello::TraceEvent::Close)) {
+            last_on_fd.erase(record.fd);
+        } else {
+            last_on_fd[record.fd] = &record;
+        }
+    }
+
+    std::cout << "\n=== Event Counts ===" << std::endl;
+    for (const auto& entry : event_counts) {
+        std::cout << "  " << std::left << std::setw(15) << hello::traceEventName(entry.first)
+                  << std::right << std::setw(12) << entry.second << std::endl;
+    }
+
+    std::cout << "\n=== Time Between Consecutive Events On A Connection (us) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(32) << "TRANSITION" << std::right
+              << std::setw(10) << "COUNT" << std::setw(12) << "P50" << std::setw(12) << "P99"
+              << std::setw(12) << "MAX" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (auto& entry : transitions) {
+        auto& deltas = entry.second;
+        std::sort(deltas.begin(), deltas.end());
+        std::string name = std::string(hello::traceEventName(entry.first.first)) + " -> " +
+                           hello::traceEventName(entry.first.second);
+        std::cout << "  " << std::left << std::setw(32) << name << std::right
+                  << std::setw(10) << deltas.size()
+                  << std::setw(12) << ticksToMicros(deltas[deltas.size() * 50 / 100], tsc_hz)
+                  << std::setw(12) << ticksToMicros(deltas[deltas.size() * 99 / 100], tsc_hz)
+                  << std::setw(12) << ticksToMicros(deltas.back(), tsc_hz) << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream file(options.path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << options.path << std::endl;
+        return 1;
+    }
+
+    hello::TraceFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != hello::TraceFileHeader::MAGIC ||
+        header.version != hello::TraceFileHeader::VERSION ||
+        header.record_size != sizeof(hello::TraceRecord)) {
+        std::cerr << options.path << " is not a gRpcSvr trace file" << std::endl;
+        return 1;
+    }
+
+    std::vector<hello::TraceRecord> records;
+    hello::TraceRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if ((options.fd >= 0 && record.fd != options.fd) ||
+            (options.worker >= 0 && record.worker != options.worker)) {
+            continue;
+        }
+        records.push_back(record);
+    }
+
+    // Workers are drained ring by ring, so restore global time order
+    std::stable_sort(records.begin(), records.end(),
+                     [](const hello::TraceRecord& a, const hello::TraceRecord& b) { return a.tsc < b.tsc; });
+
+    std::cout << "Trace: " << options.path << std::endl;
+    std::cout << "TSC frequency: " << header.tsc_hz / 1e6 << " MHz" << std::endl;
+    std::cout << "Records: " << records.size() << std::endl;
+
+    if (!options.summary_only) {
+        std::unordered_map<int32_t, uint64_t> last_tsc_on_fd;
+        size_t printed = 0;
+
+        std::cout << "\n" << std::right << std::setw(14) << "TIME(us)" << std::setw(8) << "WORKER"
+                  << std::setw(8) << "FD" << "  " << std::left << std::setw(15) << "EVENT"
+                  << std::right << std::setw(8) << "AUX" << std::setw(14) << "DELTA(us)" << std::endl;
+
+        std::cout << std::fixed << std::setprecision(3);
+        for (const auto& r : records) {
+            if (options.limit > 0 && printed++ >= options.limit) break;
+
+            double time_us = r.tsc >= header.start_tsc ? ticksToMicros(r.tsc - header.start_tsc, header.tsc_hz) : 0.0;
+            auto last = last_tsc_on_fd.find(r.fd);
+            std::cout << std::right << std::setw(14) << time_us << std::setw(8) << static_cast<int>(r.worker)
+                      << std::setw(8) << r.fd << "  " << std::left << std::setw(15) << hello::traceEventName(r.event)
+                      << std::right << std::setw(8) << r.aux;
+            if (last != last_tsc_on_fd.end() && r.tsc >= last->second) {
+                std::cout << std::setw(14) << ticksToMicros(r.tsc - last->second, header.tsc_hz);
+            }
+            std::cout << std::endl;
+            last_tsc_on_fd[r.fd] = r.tsc;
+        }
+    }
+
+    printSummary(records, header.tsc_hz);
+    return 0;
+}
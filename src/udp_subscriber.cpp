@@ -0,0 +1,93 @@
+#include "UdpFanout.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <signal.h>
+
+// Receives the epoll server's UDP fan-out (gRpcSvr_epoll --udp-publish) with
+// recvmmsg and reports throughput, sequence gaps and one-way latency (the
+// publisher stamps each update, so both ends must share a clock: same host)
+namespace {
+
+volatile sig_atomic_t g_running = 1;
+
+void signalHandler(int /*signum*/) {
+    g_running = 0;
+}
+
+uint64_t wallMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cout << "Usage: " << argv[0] << " <port> [multicast_group|-] [seconds]" << std::endl;
+        std::cout << "Example: " << argv[0] << " 50060" << std::endl;
+        std::cout << "Example: " << argv[0] << " 50061 239.1.1.1 10" << std::endl;
+        return 1;
+    }
+
+    uint16_t port = static_cast<uint16_t>(std::stoi(argv[1]));
+    std::string group = argc > 2 && std::string(argv[2]) != "-" ? argv[2] : "";
+    int seconds = argc > 3 ? std::stoi(argv[3]) : 10;
+
+    hello::UdpSubscriber subscriber;
+    if (!subscriber.open(port, group)) {
+        return 1;
+    }
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    std::cout << "=== UDP Fan-out Subscriber ===" << std::endl;
+    std::cout << "Port: " << port << (group.empty() ? "" : ", group " + group) << ", for " << seconds << "s" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    std::vector<hello::UdpSubscriber::Update> updates(hello::UdpSubscriber::MAX_BATCH);
+    std::vector<uint64_t> latencies;
+    latencies.reserve(1000000);
+    std::string sample;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::seconds(seconds);
+    while (g_running && std::chrono::steady_clock::now() < deadline) {
+        int received = subscriber.receive(updates.data(), 100);
+        if (received < 0) {
+            std::cerr << "recvmmsg failed" << std::endl;
+            return 1;
+        }
+        uint64_t now_us = wallMicros();
+        for (int i = 0; i < received; ++i) {
+            const auto& update = updates[i];
+            if (latencies.size() < latencies.capacity()) {
+                latencies.push_back(now_us > update.timestamp_us ? now_us - update.timestamp_us : 0);
+            }
+            if (sample.empty()) {
+                sample = std::string(update.message);
+            }
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto& stats = subscriber.stats();
+    std::cout << "Updates received: " << stats.updates << " (" << static_cast<uint64_t>(stats.updates / elapsed)
+              << " per second)" << std::endl;
+    std::cout << "Datagrams per recvmmsg: "
+              << (stats.receive_calls > 0 ? static_cast<double>(stats.datagrams) / stats.receive_calls : 0.0) << std::endl;
+    std::cout << "Missing (sequence gaps): " << stats.missing << std::endl;
+    std::cout << "Out of order / duplicate: " << stats.out_of_order << std::endl;
+    std::cout << "Malformed datagrams: " << stats.malformed << std::endl;
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "One-way latency: p50 " << latencies[latencies.size() * 50 / 100] << " μs, p99 "
+                  << latencies[latencies.size() * 99 / 100] << " μs, max " << latencies.back() << " μs" << std::endl;
+    }
+    if (!sample.empty()) {
+        std::cout << "Sample update: " << sample << std::endl;
+    }
+    return 0;
+}
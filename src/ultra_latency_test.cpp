@@ -452,7 +452,7 @@ private:
         std::vector<uint8_t> request = {
             0x00, 0x00, 0x14, // Length: 20 bytes
             0x01, // Type: HEADERS
-            0x04, // Flags: END_HEADERS
+            0x05, // Flags: END_STREAM | END_HEADERS (no DATA follows)
             0x00, 0x00, 0x00, 0x01, // Stream ID: 1
             // HTTP/2 headers (minimal)
             ':','m','e','t','h','o','d',':','P','O','S','T','\r','\n',